@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <delimiter_index.hpp>
+#include <feature/row.hpp>
+#include <parser.hpp>
+
+/**
+ * @brief Return raw match data lines with the given number of players each,
+ * separated by newlines.
+ */
+static std::string make_raw_lines(size_t num_lines, size_t num_players) {
+    std::mt19937 gen(2018);
+    std::uniform_int_distribution<int> type(0, 4);
+    std::uniform_int_distribution<int> jersey(1, 99);
+    std::uniform_real_distribution<double> x(0, 105);
+    std::uniform_real_distribution<double> y(0, 68);
+    std::string lines;
+    for (size_t line = 0; line < num_lines; ++line) {
+        lines += "116001217\t" + std::to_string(78392209 + 100 * line) +
+                 "\t1\t" + std::to_string(line / 600) + "\t" +
+                 std::to_string(line / 10 % 60) + "\t";
+        for (size_t i = 0; i < num_players; ++i) {
+            char player[64];
+            std::snprintf(player, sizeof(player), "%d,%d,%d,%.2f,%.2f ",
+                          type(gen), 4000 + static_cast<int>(i), jersey(gen),
+                          x(gen), y(gen));
+            lines += player;
+        }
+        lines += "\n";
+    }
+    return lines;
+}
+
+/**
+ * @brief Return the time in seconds of calling f num_calls times.
+ */
+template <typename Function>
+static double time_of(Function f, size_t num_calls) {
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_calls; ++i) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = end - begin;
+    return elapsed.count();
+}
+
+/**
+ * @brief Microbenchmark of the delimiter scanning kernels compared to parsing
+ * the same raw match data lines with parse_into, line by line and from an
+ * index of the whole buffer.
+ */
+int main() {
+    constexpr size_t num_lines = 20000;
+    constexpr size_t num_calls = 20;
+    const std::string lines = make_raw_lines(num_lines, 25);
+    const char* begin = lines.data();
+    const char* end = begin + lines.size();
+    const double gigabytes = lines.size() * num_calls / 1e9;
+    std::cout << "CPU supports " << simd_level_name(simd_level()) << std::endl;
+    std::cout << lines.size() / num_lines << " bytes per line" << std::endl;
+
+    // scan the whole buffer and count the lines
+    std::vector<DelimiterMasks> masks(delimiter_blocks(lines.size()));
+    for (SimdLevel level :
+         {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2}) {
+        size_t checksum = 0;
+        const double seconds = time_of(
+            [&]() {
+                scan_delimiters(begin, end, masks.data(), level);
+                for (const auto& m : masks) {
+                    checksum += __builtin_popcountll(m.newline);
+                }
+            },
+            num_calls);
+        std::cout << "scan " << simd_level_name(level) << ": "
+                  << gigabytes / seconds << " GB/s (checksum " << checksum
+                  << ")" << std::endl;
+    }
+
+    // parse the lines one by one into the same row
+    feature::Row row;
+    size_t checksum = 0;
+    double seconds = time_of(
+        [&]() {
+            for (const char* line = begin; line != end;) {
+                const char* newline = line;
+                while (*newline != '\n') {
+                    ++newline;
+                }
+                checksum += parse_into(line, newline, row).ok();
+                checksum += row.players.size();
+                line = newline + 1;
+            }
+        },
+        num_calls);
+    std::cout << "parse_into: " << gigabytes / seconds << " GB/s, "
+              << num_lines * num_calls / seconds / 1e6
+              << " M lines/s (checksum " << checksum << ")" << std::endl;
+
+    // index the whole buffer once and parse the lines from the index
+    DelimiterIndex index;
+    checksum = 0;
+    seconds = time_of(
+        [&]() {
+            index.scan(begin, end);
+            for (const char* line = begin; line != end;) {
+                const char* newline = index.find(line, end, delim_newline);
+                checksum += parse_into(index, line, newline, row).ok();
+                checksum += row.players.size();
+                line = newline + 1;
+            }
+        },
+        num_calls);
+    std::cout << "indexed parse_into: " << gigabytes / seconds << " GB/s, "
+              << num_lines * num_calls / seconds / 1e6
+              << " M lines/s (checksum " << checksum << ")" << std::endl;
+}
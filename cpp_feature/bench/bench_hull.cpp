@@ -0,0 +1,106 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <feature/stats/convex_hull.hpp>
+#include <feature/stats/hull_tracker.hpp>
+
+using namespace feature;
+using namespace feature::details;
+
+/**
+ * @brief Generate frames of 11 players moving around their positions in a
+ * formation with the given step size in metres. As in the raw files, the
+ * players of each frame are in a different order.
+ */
+static std::vector<player_seq> random_walk(size_t num_frames, double step) {
+    std::mt19937 gen(2018);
+    std::uniform_real_distribution<double> x(20, 85);
+    std::uniform_real_distribution<double> y(10, 58);
+    std::normal_distribution<double> move(0, step);
+
+    // each player stays around its position in the formation
+    player_seq formation;
+    for (int id = 0; id < 11; ++id) {
+        formation.emplace_back(0, id, id, x(gen), y(gen));
+    }
+    player_seq players = formation;
+    std::vector<player_seq> frames;
+    for (size_t f = 0; f < num_frames; ++f) {
+        for (size_t i = 0; i < players.size(); ++i) {
+            Player& p = players[i];
+            p.x = formation[i].x + 0.95 * (p.x - formation[i].x) + move(gen);
+            p.y = formation[i].y + 0.95 * (p.y - formation[i].y) + move(gen);
+        }
+        frames.push_back(players);
+        std::shuffle(frames.back().begin(), frames.back().end(), gen);
+    }
+    return frames;
+}
+
+/**
+ * @brief Return the average time per frame in microseconds of computing the
+ * hull of each frame using the given function.
+ */
+template <typename Function>
+static double time_per_frame(const std::vector<player_seq>& frames,
+                             Function func) {
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& players : frames) {
+        func(players);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - begin;
+    return elapsed.count() / frames.size();
+}
+
+/**
+ * @brief Microbenchmark of convex_hull against HullTracker on consecutive
+ * frames of a team at 1 Hz and 10 Hz.
+ */
+int main() {
+    constexpr size_t num_frames = 200000;
+    std::vector<int> order;
+    std::vector<int> hull;
+    for (double step : {3.0, 0.3}) {
+        const auto frames = random_walk(num_frames, step);
+        size_t full_checksum = 0;
+        size_t tracker_checksum = 0;
+        const double full_time = time_per_frame(
+            frames, [&](const player_seq& players) {
+                convex_hull(players.begin(), players.end(), order, hull);
+                full_checksum += hull.size() * hull[0];
+            });
+
+        HullTracker tracker;
+        const double tracker_time = time_per_frame(
+            frames, [&](const player_seq& players) {
+                tracker.update(players.begin(), players.end(), order, hull);
+                tracker_checksum += hull.size() * hull[0];
+            });
+
+        std::cout << "step = " << step << " m: convex_hull " << full_time
+                  << " us, HullTracker " << tracker_time << " us ("
+                  << 100.0 * tracker.rebuilds() / num_frames
+                  << "% rebuilds, checksums " << full_checksum << " and "
+                  << tracker_checksum << ")" << std::endl;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <dkm/dkm.hpp>
+
+#include <feature/stats/dkm_utils.hpp>
+
+using namespace feature::details;
+
+/**
+ * @brief Run the given function on each input and return the average time
+ * per call in microseconds.
+ */
+template <typename Function>
+double time_per_call(const std::vector<dkm_point_seq<2>>& inputs,
+                     int repeats, Function func) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (const auto& points : inputs) {
+            func(points);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - begin;
+    return elapsed.count() / (repeats * inputs.size());
+}
+
+/**
+ * @brief Microbenchmark of a single k-means run on player sized inputs using
+ * dkm::kmeans_lloyd and KMeans, which uses small_lloyd.
+ */
+int main() {
+    constexpr int repeats = 50;
+    constexpr size_t num_inputs = 1000;
+
+    // random positions of 22 players on a 105x68 pitch
+    std::mt19937 gen(2018);
+    std::uniform_real_distribution<double> x(-52.5, 52.5);
+    std::uniform_real_distribution<double> y(-34, 34);
+    std::vector<dkm_point_seq<2>> inputs(num_inputs, dkm_point_seq<2>(22));
+    for (auto& points : inputs) {
+        for (auto& p : points) {
+            p = {x(gen), y(gen)};
+        }
+    }
+
+    for (uint32_t k : {2, 4}) {
+        uint64_t checksum = 0;
+        const double dkm_time =
+            time_per_call(inputs, repeats, [&](const dkm_point_seq<2>& points) {
+                auto means = dkm::kmeans_lloyd(points, k);
+                checksum += std::get<1>(means)[0];
+            });
+
+        KMeans<2> clustering;
+        kmeans_engine engine;
+        const double kernel_time =
+            time_per_call(inputs, repeats, [&](const dkm_point_seq<2>& points) {
+                clustering.fit(points, k, 1, engine);
+                checksum += clustering.point_labels()[0];
+            });
+
+        std::cout << "k = " << k << ": dkm::kmeans_lloyd " << dkm_time
+                  << " us, KMeans::fit " << kernel_time << " us ("
+                  << dkm_time / kernel_time << "x, checksum " << checksum
+                  << ")" << std::endl;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <pairwise_distance.hpp>
+
+/**
+ * @brief Return the average time per call in nanoseconds of summing the
+ * pairwise distances of the given points using the given SimdLevel.
+ */
+static double time_per_call(const std::vector<double>& xs,
+                            const std::vector<double>& ys, size_t n,
+                            SimdLevel level, size_t num_calls,
+                            double& checksum) {
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_calls; ++i) {
+        checksum += pairwise_distance_sum(xs.data(), ys.data(), n, level);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::nano> elapsed = end - begin;
+    return elapsed.count() / num_calls;
+}
+
+/**
+ * @brief Microbenchmark of the pairwise distance kernels for a team and for
+ * all the players of a frame.
+ */
+int main() {
+    constexpr size_t num_calls = 1000000;
+    std::mt19937 gen(2018);
+    std::uniform_real_distribution<double> x(0, 105);
+    std::uniform_real_distribution<double> y(0, 68);
+    std::cout << "CPU supports " << simd_level_name(simd_level()) << std::endl;
+    for (size_t n : {11, 22}) {
+        std::vector<double> xs(pairwise_padded_size(n), 0);
+        std::vector<double> ys(pairwise_padded_size(n), 0);
+        for (size_t i = 0; i < n; ++i) {
+            xs[i] = x(gen);
+            ys[i] = y(gen);
+        }
+        for (SimdLevel level : {SimdLevel::scalar, SimdLevel::sse2,
+                                SimdLevel::avx2, SimdLevel::avx512}) {
+            double checksum = 0;
+            const double time =
+                time_per_call(xs, ys, n, level, num_calls, checksum);
+            std::cout << "n = " << n << ", " << simd_level_name(level) << ": "
+                      << time << " ns (checksum " << checksum << ")"
+                      << std::endl;
+        }
+    }
+}
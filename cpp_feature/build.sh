@@ -44,6 +44,7 @@ elif [[ ${build} == "clean" ]]; then
 	rm -rf build ||:
 	rm -rf doc ||:
 	rm feature 2> /dev/null ||:
+	rm raw2bin 2> /dev/null ||:
 	exit
 else
 	echo "Unknown build type: Use one of debug, release, clean"
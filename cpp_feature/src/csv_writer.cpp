@@ -0,0 +1,106 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "csv_writer.hpp"
+#include "double_format.hpp"
+
+CsvWriter::CsvWriter(const std::string& filepath, int precision_,
+                     size_t buffer_size)
+    : file(filepath, std::ofstream::binary), precision(precision_),
+      buffer(std::max(buffer_size, 2 * max_formatted_double_size)), used(0) {
+    if (!this->file) {
+        throw std::runtime_error("Cannot open file: " + filepath);
+    }
+    if (this->precision != shortest &&
+        (this->precision < 0 || this->precision > max_fixed_precision)) {
+        throw std::runtime_error("Invalid precision");
+    }
+}
+
+CsvWriter::~CsvWriter() {
+    // destructors must not throw; errors are ignored
+    this->file.write(this->buffer.data(), this->used);
+}
+
+void CsvWriter::write(const std::string& str) {
+    if (str.size() > this->buffer.size()) {
+        this->flush();
+        this->file.write(str.data(), str.size());
+        return;
+    }
+    this->reserve(str.size());
+    std::memcpy(this->buffer.data() + this->used, str.data(), str.size());
+    this->used += str.size();
+}
+
+void CsvWriter::write(char c) {
+    this->reserve(1);
+    this->buffer[this->used++] = c;
+}
+
+void CsvWriter::write(long value) {
+    constexpr size_t max_long_size = 24;
+    this->reserve(max_long_size);
+
+    // write digits backwards to a temporary buffer
+    char tmp[max_long_size];
+    char* end = tmp + max_long_size;
+    char* it = end;
+    unsigned long magnitude = value < 0 ? 0UL - static_cast<unsigned long>(value)
+                                        : static_cast<unsigned long>(value);
+    do {
+        *--it = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *--it = '-';
+    }
+
+    std::memcpy(this->buffer.data() + this->used, it, end - it);
+    this->used += end - it;
+}
+
+void CsvWriter::write(int value) { this->write(static_cast<long>(value)); }
+
+void CsvWriter::write(double value) {
+    this->reserve(max_formatted_double_size);
+    char* begin = this->buffer.data() + this->used;
+    char* end = (this->precision == shortest)
+                    ? format_shortest(value, begin)
+                    : format_fixed(value, this->precision, begin);
+    this->used += end - begin;
+}
+
+void CsvWriter::end_row() { this->write('\n'); }
+
+void CsvWriter::flush() {
+    this->file.write(this->buffer.data(), this->used);
+    this->file.flush();
+    this->used = 0;
+    if (!this->file) {
+        throw std::runtime_error("Cannot write to CSV file");
+    }
+}
+
+void CsvWriter::reserve(size_t n) {
+    if (this->used + n > this->buffer.size()) {
+        this->flush();
+    }
+}
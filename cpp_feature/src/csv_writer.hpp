@@ -0,0 +1,129 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief CsvWriter writes CSV files using a fixed size buffer that is flushed
+ * to the file in chunks.
+ *
+ * The memory used by CsvWriter doesn't depend on the number of rows written.
+ * Doubles are formatted using format_fixed or format_shortest instead of
+ * iostreams.
+ *
+ * Example:
+ * @code
+ *     CsvWriter writer("out.csv");
+ *     writer.write("a,b");
+ *     writer.end_row();
+ *     writer.write(1);
+ *     writer.write(',');
+ *     writer.write(2.5);
+ *     writer.end_row();
+ * @endcode
+ */
+class CsvWriter {
+  public:
+    /**
+     * @brief Precision value to write doubles using their shortest round-trip
+     * representation.
+     */
+    static constexpr int shortest = -1;
+
+    /**
+     * @brief Open the CSV file in the given filepath for writing.
+     *
+     * @param filepath Path to the CSV file to write.
+     * @param precision Number of digits to write after the decimal point of
+     * doubles, or CsvWriter::shortest.
+     * @param buffer_size Number of bytes to buffer before writing to the file.
+     *
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    explicit CsvWriter(const std::string& filepath, int precision = 12,
+                       size_t buffer_size = 1 << 16);
+
+    /**
+     * @brief Flush the buffered bytes and close the file.
+     */
+    ~CsvWriter();
+
+    /**
+     * @brief Write the given string as is.
+     */
+    void write(const std::string& str);
+
+    /**
+     * @brief Write the given character.
+     */
+    void write(char c);
+
+    /**
+     * @brief Write the given integer in decimal notation.
+     */
+    void write(long value);
+
+    /**
+     * @brief Write the given integer in decimal notation.
+     */
+    void write(int value);
+
+    /**
+     * @brief Write the given double using the precision of this writer.
+     */
+    void write(double value);
+
+    /**
+     * @brief End the current row by writing a newline character.
+     */
+    void end_row();
+
+    /**
+     * @brief Write all the buffered bytes to the file.
+     *
+     * @throws std::runtime_error if the bytes cannot be written.
+     */
+    void flush();
+
+  private:
+    /**
+     * @brief Make sure that at least n bytes can be appended to the buffer.
+     */
+    void reserve(size_t n);
+
+  private:
+    /**
+     * @brief Output file.
+     */
+    std::ofstream file;
+    /**
+     * @brief Number of digits after the decimal point or CsvWriter::shortest.
+     */
+    int precision;
+    /**
+     * @brief Buffered bytes.
+     */
+    std::vector<char> buffer;
+    /**
+     * @brief Number of bytes used in the buffer.
+     */
+    size_t used;
+};
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DELIMITER_X86 1
+#include <immintrin.h>
+#endif
+
+#include "delimiter_index.hpp"
+
+/**
+ * @brief Classify the bytes of a block of at most delimiter_block_size bytes
+ * one by one.
+ */
+static DelimiterMasks block_scalar(const char* block, size_t size) {
+    DelimiterMasks masks = {0, 0, 0, 0};
+    for (size_t i = 0; i < size; ++i) {
+        const uint64_t bit = uint64_t(1) << i;
+        switch (block[i]) {
+        case '\t':
+            masks.tab |= bit;
+            break;
+        case ' ':
+            masks.space |= bit;
+            break;
+        case ',':
+            masks.comma |= bit;
+            break;
+        case '\n':
+            masks.newline |= bit;
+            break;
+        }
+    }
+    return masks;
+}
+
+/**
+ * @brief Scalar reference kernel.
+ */
+static void scan_scalar(const char* begin, const char* end,
+                        DelimiterMasks* masks) {
+    const size_t n = static_cast<size_t>(end - begin);
+    for (size_t i = 0; i < n; i += delimiter_block_size) {
+        *masks++ = block_scalar(begin + i,
+                                std::min(delimiter_block_size, n - i));
+    }
+}
+
+#ifdef DELIMITER_X86
+
+/**
+ * @brief Return the mask of the bytes of the 64 byte block given as four
+ * vectors that are equal to the bytes of c.
+ */
+static inline uint64_t eq_mask_sse2(const __m128i* v, __m128i c) {
+    const uint64_t m0 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[0], c)));
+    const uint64_t m1 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[1], c)));
+    const uint64_t m2 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[2], c)));
+    const uint64_t m3 = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[3], c)));
+    return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+}
+
+/**
+ * @brief Classify a full block of delimiter_block_size bytes using SSE2.
+ */
+static inline DelimiterMasks block_sse2(const char* block) {
+    __m128i v[4];
+    for (int i = 0; i < 4; ++i) {
+        v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block) + i);
+    }
+    return {eq_mask_sse2(v, _mm_set1_epi8('\t')),
+            eq_mask_sse2(v, _mm_set1_epi8(' ')),
+            eq_mask_sse2(v, _mm_set1_epi8(',')),
+            eq_mask_sse2(v, _mm_set1_epi8('\n'))};
+}
+
+/**
+ * @brief SSE2 kernel. The last partial block is copied to a zero padded
+ * buffer so that no byte after end is read.
+ */
+static void scan_sse2(const char* begin, const char* end,
+                      DelimiterMasks* masks) {
+    const size_t n = static_cast<size_t>(end - begin);
+    size_t i = 0;
+    for (; i + delimiter_block_size <= n; i += delimiter_block_size) {
+        *masks++ = block_sse2(begin + i);
+    }
+    if (i != n) {
+        char tail[delimiter_block_size] = {0};
+        std::memcpy(tail, begin + i, n - i);
+        *masks = block_sse2(tail);
+    }
+}
+
+/**
+ * @brief Same as eq_mask_sse2 for a block given as two AVX2 vectors.
+ */
+__attribute__((target("avx2"))) static inline uint64_t
+eq_mask_avx2(const __m256i* v, __m256i c) {
+    const uint64_t m0 =
+        uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v[0], c)));
+    const uint64_t m1 =
+        uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v[1], c)));
+    return m0 | (m1 << 32);
+}
+
+/**
+ * @brief Classify a full block of delimiter_block_size bytes using AVX2.
+ */
+__attribute__((target("avx2"))) static inline DelimiterMasks
+block_avx2(const char* block) {
+    __m256i v[2];
+    for (int i = 0; i < 2; ++i) {
+        v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block) + i);
+    }
+    return {eq_mask_avx2(v, _mm256_set1_epi8('\t')),
+            eq_mask_avx2(v, _mm256_set1_epi8(' ')),
+            eq_mask_avx2(v, _mm256_set1_epi8(',')),
+            eq_mask_avx2(v, _mm256_set1_epi8('\n'))};
+}
+
+/**
+ * @brief AVX2 kernel. The last partial block is handled as in scan_sse2.
+ */
+__attribute__((target("avx2"))) static void
+scan_avx2(const char* begin, const char* end, DelimiterMasks* masks) {
+    const size_t n = static_cast<size_t>(end - begin);
+    size_t i = 0;
+    for (; i + delimiter_block_size <= n; i += delimiter_block_size) {
+        *masks++ = block_avx2(begin + i);
+    }
+    if (i != n) {
+        char tail[delimiter_block_size] = {0};
+        std::memcpy(tail, begin + i, n - i);
+        *masks = block_avx2(tail);
+    }
+}
+
+#endif
+
+void scan_delimiters(const char* begin, const char* end,
+                     DelimiterMasks* masks) {
+    scan_delimiters(begin, end, masks, simd_level());
+}
+
+void scan_delimiters(const char* begin, const char* end, DelimiterMasks* masks,
+                     SimdLevel level) {
+    level = std::min(level, simd_level());
+    switch (level) {
+#ifdef DELIMITER_X86
+    // AVX-512 gives no gain over AVX2 for a few blocks per line
+    case SimdLevel::avx512:
+    case SimdLevel::avx2:
+        scan_avx2(begin, end, masks);
+        return;
+    case SimdLevel::sse2:
+        scan_sse2(begin, end, masks);
+        return;
+#endif
+    default:
+        scan_scalar(begin, end, masks);
+    }
+}
+
+DelimiterIndex::DelimiterIndex() : begin(nullptr) {}
+
+void DelimiterIndex::scan(const char* begin, const char* end) {
+    this->begin = begin;
+    this->masks.resize(delimiter_blocks(end - begin));
+    scan_delimiters(begin, end, this->masks.data());
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "simd.hpp"
+#include "small_vector.hpp"
+
+/**
+ * @brief Number of bytes whose delimiters are kept in a single DelimiterMasks.
+ */
+constexpr size_t delimiter_block_size = 64;
+
+/**
+ * @brief Delimiters that are searched in raw match data. Sets of delimiters
+ * are given as bitwise or of these values.
+ */
+constexpr unsigned delim_tab = 1u << 0;
+constexpr unsigned delim_space = 1u << 1;
+constexpr unsigned delim_comma = 1u << 2;
+constexpr unsigned delim_newline = 1u << 3;
+
+/**
+ * @brief Positions of the delimiters in a block of delimiter_block_size bytes.
+ *
+ * Bit i of a mask is set iff byte i of the block is the corresponding
+ * delimiter.
+ */
+struct DelimiterMasks {
+    uint64_t tab;
+    uint64_t space;
+    uint64_t comma;
+    uint64_t newline;
+
+    /**
+     * @brief Return the positions of any of the given set of delimiters.
+     */
+    uint64_t select(unsigned delims) const {
+        return ((delims & delim_tab) ? this->tab : 0) |
+               ((delims & delim_space) ? this->space : 0) |
+               ((delims & delim_comma) ? this->comma : 0) |
+               ((delims & delim_newline) ? this->newline : 0);
+    }
+};
+
+/**
+ * @brief Return the number of DelimiterMasks needed for n bytes.
+ */
+constexpr size_t delimiter_blocks(size_t n) {
+    return (n + delimiter_block_size - 1) / delimiter_block_size;
+}
+
+/**
+ * @brief Find all tab, space, comma and newline characters in [begin, end) in
+ * a single pass using the widest kernel supported by the CPU.
+ *
+ * This is the first stage of a simdjson style parser: every byte of the range
+ * is classified exactly once with vector comparisons, and the parser then
+ * finds the fields using bit operations on the masks instead of searching
+ * the bytes again.
+ *
+ * @param begin Beginning of the character range.
+ * @param end End of the character range. No byte at or after end is read.
+ * @param masks Output array of delimiter_blocks(end - begin) elements where
+ * masks[k] keeps the delimiters of bytes [begin + 64k, begin + 64(k + 1)).
+ * Bits of the bytes at or after end are 0.
+ */
+void scan_delimiters(const char* begin, const char* end, DelimiterMasks* masks);
+
+/**
+ * @brief Same as the function above where the kernel of the given SimdLevel
+ * is used. If the CPU doesn't support the given level, the widest supported
+ * level is used.
+ */
+void scan_delimiters(const char* begin, const char* end, DelimiterMasks* masks,
+                     SimdLevel level);
+
+/**
+ * @brief DelimiterIndex keeps the delimiter masks of a character range and
+ * finds delimiters in it without reading the characters again.
+ *
+ * The masks of ranges up to inline_blocks * delimiter_block_size bytes are
+ * kept inside the object; hence, indexing a raw match data line doesn't
+ * allocate any memory. Larger ranges, such as the windows of a raw match data
+ * file indexed by RawReader, reuse the memory of the previous masks.
+ *
+ * Example:
+ * @code
+ *     DelimiterIndex index;
+ *     index.scan(line.data(), line.data() + line.size());
+ *     const char* tab = index.find(line.data(), line.data() + line.size(),
+ *                                  delim_tab);
+ * @endcode
+ */
+class DelimiterIndex {
+  public:
+    /**
+     * @brief Number of blocks whose masks are kept without allocating memory.
+     */
+    static constexpr size_t inline_blocks = 32;
+
+    /**
+     * @brief Construct an empty index.
+     */
+    DelimiterIndex();
+
+    /**
+     * @brief Index the delimiters of [begin, end) using scan_delimiters.
+     *
+     * The range must stay valid while the index is used. Memory of the
+     * previous masks is reused.
+     */
+    void scan(const char* begin, const char* end);
+
+    /**
+     * @brief Return a pointer to the first of the given set of delimiters in
+     * [from, last), or last if there is no such delimiter.
+     *
+     * @param from Beginning of the search in the indexed range.
+     * @param last End of the search in the indexed range; from <= last.
+     * @param delims Bitwise or of delim_tab, delim_space, delim_comma and
+     * delim_newline.
+     */
+    const char* find(const char* from, const char* last, unsigned delims) const;
+
+  private:
+    friend class DelimiterStream;
+
+    /**
+     * @brief Beginning of the indexed range.
+     */
+    const char* begin;
+    /**
+     * @brief Delimiter masks of the indexed range.
+     */
+    SmallVector<DelimiterMasks, inline_blocks> masks;
+};
+
+// find is called for every field of a line; hence, it is defined in the header
+// so that it can be inlined into the caller.
+inline const char* DelimiterIndex::find(const char* from, const char* last,
+                                        unsigned delims) const {
+    if (from >= last) {
+        return last;
+    }
+    const size_t offset = static_cast<size_t>(from - this->begin);
+    const size_t last_block = delimiter_blocks(last - this->begin);
+    size_t block = offset / delimiter_block_size;
+    uint64_t mask = this->masks[block].select(delims) &
+                    (~uint64_t(0) << (offset % delimiter_block_size));
+    while (mask == 0) {
+        if (++block == last_block) {
+            return last;
+        }
+        mask = this->masks[block].select(delims);
+    }
+    const char* pos =
+        this->begin + block * delimiter_block_size + __builtin_ctzll(mask);
+    return pos < last ? pos : last;
+}
+
+/**
+ * @brief DelimiterStream walks through the delimiters of a set in a part of
+ * the range of a DelimiterIndex in ascending order.
+ *
+ * This is the second stage of a simdjson style parser: each delimiter is
+ * found with a single bit scan of the masks of the index; hence, walking
+ * through all the fields of a line costs less than searching each field
+ * separately with DelimiterIndex::find.
+ *
+ * Example:
+ * @code
+ *     DelimiterStream commas(index, begin, end, delim_comma);
+ *     for (const char* c = commas.next(); c != end; c = commas.next()) {
+ *         // use c
+ *     }
+ * @endcode
+ */
+class DelimiterStream {
+  public:
+    /**
+     * @brief Construct a stream of the given set of delimiters in [from, last).
+     *
+     * @param index DelimiterIndex whose indexed range contains [from, last).
+     * @param from Beginning of the stream.
+     * @param last End of the stream; from <= last.
+     * @param delims Bitwise or of delim_tab, delim_space, delim_comma and
+     * delim_newline.
+     */
+    DelimiterStream(const DelimiterIndex& index, const char* from,
+                    const char* last, unsigned delims)
+        : block_begin(index.begin +
+                      (from - index.begin) / delimiter_block_size *
+                          delimiter_block_size),
+          last(last), delims(delims) {
+        const size_t offset = static_cast<size_t>(from - index.begin);
+        const DelimiterMasks* masks = index.masks.data();
+        this->block = masks + offset / delimiter_block_size;
+        this->last_block = masks + delimiter_blocks(last - index.begin);
+        this->mask = (from < last)
+                         ? this->block->select(delims) &
+                               (~uint64_t(0) << (offset % delimiter_block_size))
+                         : 0;
+    }
+
+    /**
+     * @brief Return a pointer to the next delimiter of the stream, or last if
+     * there are no more delimiters.
+     */
+    const char* next() {
+        while (this->mask == 0) {
+            if (this->block + 1 >= this->last_block) {
+                return this->last;
+            }
+            ++this->block;
+            this->block_begin += delimiter_block_size;
+            this->mask = this->block->select(this->delims);
+        }
+        const char* pos = this->block_begin + __builtin_ctzll(this->mask);
+        this->mask &= this->mask - 1;
+        return pos < this->last ? pos : this->last;
+    }
+
+  private:
+    /**
+     * @brief Masks of the current block.
+     */
+    const DelimiterMasks* block;
+    /**
+     * @brief One past the masks of the last block of the stream.
+     */
+    const DelimiterMasks* last_block;
+    /**
+     * @brief Beginning of the bytes of the current block.
+     */
+    const char* block_begin;
+    /**
+     * @brief End of the stream.
+     */
+    const char* last;
+    /**
+     * @brief Set of delimiters of the stream.
+     */
+    unsigned delims;
+    /**
+     * @brief Delimiters of the current block that are not returned yet.
+     */
+    uint64_t mask;
+};
@@ -0,0 +1,355 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "double_format.hpp"
+
+/**
+ * @brief Write the decimal digits of the given integer with at least
+ * min_digits digits (padded with leading zeros) to the end of the buffer that
+ * ends at end.
+ *
+ * @return Pointer to the first digit written.
+ */
+template <typename UInt>
+static char* write_digits_backwards(UInt value, int min_digits, char* end) {
+    char* it = end;
+    // most values fit in 64 bits; 64 bit division is much faster
+    while (value > UINT64_MAX) {
+        *--it = static_cast<char>('0' + static_cast<int>(value % 10));
+        value /= 10;
+        --min_digits;
+    }
+    uint64_t small = static_cast<uint64_t>(value);
+    do {
+        *--it = static_cast<char>('0' + small % 10);
+        small /= 10;
+        --min_digits;
+    } while (small != 0);
+    while (min_digits > 0) {
+        *--it = '0';
+        --min_digits;
+    }
+    return it;
+}
+
+/**
+ * @brief Format the given value using std::snprintf with the given format.
+ */
+static char* format_snprintf(const char* format, int precision, double value,
+                             char* buffer) {
+    int len = std::snprintf(buffer, max_formatted_double_size, format,
+                            precision, value);
+    return buffer + len;
+}
+
+char* format_fixed(double value, int precision, char* buffer) {
+#ifdef __SIZEOF_INT128__
+    typedef unsigned __int128 uint128;
+
+    // nan and inf are formatted by the C library
+    if (!std::isfinite(value) || precision < 0 || precision > 17) {
+        return format_snprintf("%.*f", precision, value, buffer);
+    }
+
+    // value = mantissa * 2^exponent exactly
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const bool negative = (bits >> 63) != 0;
+    const int biased_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+    uint64_t mantissa = bits & ((uint64_t(1) << 52) - 1);
+    int exponent;
+    if (biased_exponent == 0) {
+        exponent = -1074; // subnormal
+    } else {
+        mantissa |= uint64_t(1) << 52;
+        exponent = biased_exponent - 1075;
+    }
+
+    // value * 10^precision = (mantissa * 5^precision) * 2^(exponent +
+    // precision). mantissa * 5^precision < 2^53 * 5^17 < 2^93.
+    uint128 scaled = mantissa;
+    for (int i = 0; i < precision; ++i) {
+        scaled *= 5;
+    }
+    const int shift = exponent + precision;
+
+    // round scaled * 2^shift to the nearest integer, ties to even, like printf
+    uint128 digits;
+    if (shift >= 0) {
+        // digits must fit in 128 bits; otherwise, let snprintf handle it
+        if (shift > 30) {
+            return format_snprintf("%.*f", precision, value, buffer);
+        }
+        digits = scaled << shift;
+    } else if (-shift >= 100) {
+        // scaled * 2^shift < 2^93 * 2^-100 < 0.5
+        digits = 0;
+    } else {
+        const int right = -shift;
+        digits = scaled >> right;
+        const uint128 remainder = scaled & ((uint128(1) << right) - 1);
+        const uint128 half = uint128(1) << (right - 1);
+        if (remainder > half || (remainder == half && (digits & 1) != 0)) {
+            ++digits;
+        }
+    }
+
+    // write the digits to the end of a temporary buffer, then copy
+    char tmp[64];
+    char* tmp_end = tmp + sizeof(tmp);
+    char* tmp_begin = write_digits_backwards(digits, precision + 1, tmp_end);
+
+    char* out = buffer;
+    if (negative) {
+        *out++ = '-';
+    }
+    const size_t num_int_digits = (tmp_end - tmp_begin) - precision;
+    std::memcpy(out, tmp_begin, num_int_digits);
+    out += num_int_digits;
+    if (precision > 0) {
+        *out++ = '.';
+        std::memcpy(out, tmp_begin + num_int_digits, precision);
+        out += precision;
+    }
+    return out;
+#else
+    return format_snprintf("%.*f", precision, value, buffer);
+#endif
+}
+
+/**
+ * @brief Format the given value by trying %g with increasing precisions until
+ * the output round trips.
+ *
+ * 17 significant digits are always enough to represent a double exactly; %g
+ * removes trailing zeros, so the first precision that round trips gives the
+ * shortest representation.
+ */
+static char* format_shortest_snprintf(double value, char* buffer) {
+    if (std::isfinite(value)) {
+        for (int precision = 15; precision < 17; ++precision) {
+            char* end = format_snprintf("%.*g", precision, value, buffer);
+            *end = '\0';
+            if (std::strtod(buffer, nullptr) == value) {
+                return end;
+            }
+        }
+    }
+    return format_snprintf("%.*g", 17, value, buffer);
+}
+
+#ifdef __SIZEOF_INT128__
+
+/**
+ * @brief Find the shortest decimal digits that convert back to the given
+ * positive or zero double using exact integer arithmetic.
+ *
+ * The rounding interval of the value is scaled by a power of 10 so that its
+ * bounds become integers with 18 or 19 digits, and then digits are removed
+ * while the interval still contains a number with fewer digits, as in the
+ * general case of the Ryu algorithm. The scaled bounds are exact 128 bit
+ * products, so no lookup tables are needed.
+ *
+ * @param bits Bits of the double without the sign bit.
+ * @param digits Output digits without trailing zeros.
+ * @param exponent Output exponent such that the value is digits *
+ * 10^exponent.
+ *
+ * @return true if the digits are found; false if the value is outside the
+ * range handled with 128 bits (about [1e-14, 1e17)) or is subnormal.
+ */
+static bool shortest_digits(uint64_t bits, uint64_t& digits, int& exponent) {
+    typedef unsigned __int128 uint128;
+
+    const int biased_exponent = static_cast<int>(bits >> 52);
+    const uint64_t fraction = bits & ((uint64_t(1) << 52) - 1);
+    if (biased_exponent == 0) {
+        if (fraction != 0) {
+            return false; // subnormal
+        }
+        digits = 0;
+        exponent = 0;
+        return true;
+    }
+
+    // value = mv * 2^e2; the rounding interval is (mm, mp) * 2^e2, and its
+    // bounds are included if the mantissa is even (round half to even).
+    const uint64_t mantissa = fraction | (uint64_t(1) << 52);
+    const int e2 = biased_exponent - 1075 - 2;
+    const bool accept_bounds = (mantissa & 1) == 0;
+    const uint64_t mv = 4 * mantissa;
+    const uint64_t mp = mv + 2;
+    // the interval below a power of 2 is half as wide
+    const uint64_t mm = mv - 1 - (fraction != 0 || biased_exponent <= 1);
+
+    // scale by 10^q = 5^q * 2^q so that the value has 18 or 19 digits;
+    // floor(k * log10(2)) = (k * 78913) >> 18 for the exponents of doubles
+    const int log10_value = ((biased_exponent - 1023) * 78913) >> 18;
+    const int q = 17 - log10_value;
+    if (q < 0 || q > 31) {
+        return false;
+    }
+    uint128 pow5 = 1;
+    for (int i = 0; i < q; ++i) {
+        pow5 *= 5;
+    }
+    const int shift = e2 + q;
+    if (shift > 0 || shift <= -128) {
+        return false;
+    }
+    // (mantissa * 5^q) < 2^55 * 5^31 < 2^128; the shift divides by 2^-shift
+    // and the shifted out bits tell whether the result is exact.
+    const int right = -shift;
+    const uint128 low_mask = (right == 0) ? 0 : (uint128(1) << right) - 1;
+    const uint128 nr = mv * pow5;
+    const uint128 np = mp * pow5;
+    const uint128 nm = mm * pow5;
+    uint64_t vr = static_cast<uint64_t>(nr >> right);
+    uint64_t vp = static_cast<uint64_t>(np >> right);
+    uint64_t vm = static_cast<uint64_t>(nm >> right);
+    bool vr_trailing_zeros = (nr & low_mask) == 0;
+    bool vm_trailing_zeros = (nm & low_mask) == 0;
+    // the upper bound itself is not allowed
+    if (!accept_bounds && (np & low_mask) == 0) {
+        --vp;
+    }
+    // the lower bound is allowed only if it is exact
+    vm_trailing_zeros &= accept_bounds;
+
+    // remove digits while the interval contains a shorter number
+    int removed = 0;
+    uint64_t last_removed_digit = 0;
+    while (vp / 10 > vm / 10) {
+        vm_trailing_zeros &= vm % 10 == 0;
+        vr_trailing_zeros &= last_removed_digit == 0;
+        last_removed_digit = vr % 10;
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++removed;
+    }
+    if (vm_trailing_zeros) {
+        while (vm % 10 == 0) {
+            vr_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+    }
+    // exactly halfway between two candidates: round half to even
+    if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+        last_removed_digit = 4;
+    }
+    digits = vr + ((vr == vm && !vm_trailing_zeros) || last_removed_digit >= 5);
+    exponent = removed - q;
+    while (digits % 10 == 0) {
+        digits /= 10;
+        ++exponent;
+    }
+    return true;
+}
+
+/**
+ * @brief Write value = (-1)^negative * digits * 10^exponent in the notation of
+ * %g with precision max(15, number of digits).
+ *
+ * This is the output of format_shortest_snprintf, which uses the first
+ * precision in [15, 17] that round trips.
+ */
+static char* write_general(bool negative, uint64_t digits, int exponent,
+                           char* buffer) {
+    char tmp[24];
+    char* tmp_end = tmp + sizeof(tmp);
+    const char* first = write_digits_backwards(digits, 1, tmp_end);
+    const int num_digits = static_cast<int>(tmp_end - first);
+    const int precision = std::max(num_digits, 15);
+    const int decimal_exponent = exponent + num_digits - 1;
+
+    char* out = buffer;
+    if (negative) {
+        *out++ = '-';
+    }
+    if (decimal_exponent < -4 || decimal_exponent >= precision) {
+        // d.ddde+XX
+        *out++ = first[0];
+        if (num_digits > 1) {
+            *out++ = '.';
+            std::memcpy(out, first + 1, num_digits - 1);
+            out += num_digits - 1;
+        }
+        *out++ = 'e';
+        *out++ = decimal_exponent < 0 ? '-' : '+';
+        const int abs_exponent = std::abs(decimal_exponent);
+        char exp_digits[8];
+        char* exp_end = exp_digits + sizeof(exp_digits);
+        const char* exp_first =
+            write_digits_backwards(uint64_t(abs_exponent), 2, exp_end);
+        std::memcpy(out, exp_first, exp_end - exp_first);
+        out += exp_end - exp_first;
+    } else if (decimal_exponent >= 0) {
+        // integer digits, padded with zeros, then the fraction digits
+        const int num_int_digits = decimal_exponent + 1;
+        if (num_digits <= num_int_digits) {
+            std::memcpy(out, first, num_digits);
+            out += num_digits;
+            std::memset(out, '0', num_int_digits - num_digits);
+            out += num_int_digits - num_digits;
+        } else {
+            std::memcpy(out, first, num_int_digits);
+            out += num_int_digits;
+            *out++ = '.';
+            std::memcpy(out, first + num_int_digits,
+                        num_digits - num_int_digits);
+            out += num_digits - num_int_digits;
+        }
+    } else {
+        // 0.000ddd
+        *out++ = '0';
+        *out++ = '.';
+        std::memset(out, '0', -decimal_exponent - 1);
+        out += -decimal_exponent - 1;
+        std::memcpy(out, first, num_digits);
+        out += num_digits;
+    }
+    return out;
+}
+
+#endif
+
+char* format_shortest(double value, char* buffer) {
+#ifdef __SIZEOF_INT128__
+    if (std::isfinite(value)) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const bool negative = (bits >> 63) != 0;
+        uint64_t digits;
+        int exponent;
+        if (shortest_digits(bits & ~(uint64_t(1) << 63), digits, exponent)) {
+            return write_general(negative, digits, exponent, buffer);
+        }
+    }
+#endif
+    return format_shortest_snprintf(value, buffer);
+}
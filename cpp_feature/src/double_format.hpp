@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Size of a buffer that is large enough to hold any double formatted by
+ * format_fixed or format_shortest.
+ */
+constexpr size_t max_formatted_double_size = 384;
+
+/**
+ * @brief Maximum precision accepted by format_fixed.
+ */
+constexpr int max_fixed_precision = 40;
+
+/**
+ * @brief Write the given double to the given buffer in fixed point notation
+ * with the given number of digits after the decimal point.
+ *
+ * The output is exactly the same as the output of
+ * @code
+ *     std::snprintf(buffer, size, "%.*f", precision, value);
+ * @endcode
+ * and therefore the same as writing the value to a std::ostream after applying
+ * std::fixed and std::setprecision(precision). The decimal digits are
+ * calculated using exact integer arithmetic for values with magnitude less than
+ * about \f$10^{18}\f$; other values are formatted using std::snprintf.
+ *
+ * The output is not null terminated.
+ *
+ * @param value Value to format.
+ * @param precision Number of digits after the decimal point. Must be in [0,
+ * max_fixed_precision].
+ * @param buffer Output buffer with at least max_formatted_double_size bytes.
+ *
+ * @return Pointer to one past the last character written.
+ */
+char* format_fixed(double value, int precision, char* buffer);
+
+/**
+ * @brief Write the shortest representation of the given double that converts
+ * back to exactly the same double when parsed.
+ *
+ * The output uses the same notation as the %g format of std::printf with
+ * precision max(15, number of digits), e.g. 0.1, 52.94, 1e-05. The shortest
+ * digits are found using exact 128 bit integer arithmetic for normal values
+ * with magnitude in about [1e-14, 1e17); other values are formatted by trying
+ * %g with precisions 15, 16 and 17 using std::snprintf until the output round
+ * trips. The output is not null terminated.
+ *
+ * @param value Value to format.
+ * @param buffer Output buffer with at least max_formatted_double_size bytes.
+ *
+ * @return Pointer to one past the last character written.
+ */
+char* format_shortest(double value, char* buffer);
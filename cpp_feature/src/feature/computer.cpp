@@ -15,113 +15,136 @@
  */
 
 #include <algorithm>
+#include <future>
 #include <iterator>
 #include <string>
 #include <vector>
 
+#include <thread_pool.hpp>
+
 #include "computer.hpp"
 #include "stats.hpp"
 
 namespace feature {
 
-Computer::Computer()
-    : curr_row(), prev_row(), prev_features(default_features()) {}
+Computer::Computer(uint64_t seed_, bool warm_start_,
+                   const details::RestartPolicy& restarts_, bool track_hulls_)
+    : seed(seed_), warm_start(warm_start_), restarts(restarts_),
+      track_hulls(track_hulls_), curr_row(), prev_features(default_features()),
+      workspace() {
+    this->workspace.track_hulls = this->track_hulls;
+}
 
 using namespace details;
 
-std::vector<double> Computer::compute_features(const Row& row) {
-    if (row.timestamp == this->prev_row.timestamp) {
-        return this->prev_features;
+const Row& Computer::grouped(const Row& row, Row& buffer) {
+    if (grouped_by_type(row.players)) {
+        return row;
     }
-    //
-    // comparator function to compare players when sorting
-    auto player_type_comp = [](const Player& p1, const Player& p2) {
-        return p1.type < p2.type;
-    };
+    buffer = row;
+    group_by_type(buffer.players);
+    return buffer;
+}
 
-    // copy and sort the current row with respect to player type
-    this->curr_row = row;
-    std::sort(this->curr_row.players.begin(), this->curr_row.players.end(),
-              player_type_comp);
+void Computer::compute_stats(const Row& curr, Workspace& workspace,
+                             std::vector<double>& features) const {
+    this->seed_engine(curr, workspace);
 
     // calculate speeds (indices are the same as players)
-    std::vector<double> speed =
-        calculate_speeds(this->curr_row, this->prev_row);
-
-    // find player_ranges for home using binary search
-    Player p;
-    p.type = player_name_to_type("home");
-    player_crange home_players =
-        std::equal_range(this->curr_row.players.cbegin(),
-                         this->curr_row.players.cend(), p, player_type_comp);
-    auto home_speed_begin =
-        std::next(speed.begin(), std::distance(this->curr_row.players.cbegin(),
-                                               home_players.first));
-
-    // find player_ranges for away using binary search
-    p.type = player_name_to_type("away");
-    player_crange away_players =
-        std::equal_range(this->curr_row.players.begin(),
-                         this->curr_row.players.end(), p, player_type_comp);
-    auto away_speed_begin =
-        std::next(speed.begin(), std::distance(this->curr_row.players.cbegin(),
-                                               away_players.first));
-
-    // home and away follow each other to create "player" range
-    player_crange both_players = {home_players.first, away_players.second};
-    auto both_speed_begin = home_speed_begin;
+    std::vector<double>& speed = workspace.speed;
+    calculate_speeds(curr, workspace.player_slots, workspace.row_slots, speed);
 
-    // referee iterators
-    int ref_type = player_name_to_type("referee");
+    // players of each type follow each other in the frame
+    Frame& frame = workspace.frame;
+    frame.assign(curr.players.cbegin(), curr.players.cend());
+    const PlayerSpan home = frame.span(PlayerType::home);
+    const PlayerSpan away = frame.span(PlayerType::away);
+    const PlayerSpan both = frame.span(PlayerType::home, PlayerType::away);
+    const PlayerSpan referees = frame.span(PlayerType::referee);
 
-    // begin iterator for referee (find referee)
-    player_cit ref_begin = std::find_if(
-        this->curr_row.players.begin(), this->curr_row.players.end(),
-        [ref_type](const Player& p) { return p.type == ref_type; });
-
-    // if no referee, keep ref_end == ref_begin
-    player_cit ref_end = ref_begin;
-    if (ref_begin != this->curr_row.players.end())
-        ref_end = std::next(ref_end);
-
-    // speed of referee
-    auto ref_speed_it =
-        std::next(speed.begin(),
-                  std::distance(this->curr_row.players.cbegin(), ref_begin));
+    // Player ranges and speeds of the spans
+    auto players = [&curr](PlayerSpan span) {
+        return player_crange(curr.players.cbegin() + span.first,
+                             curr.players.cbegin() + span.last);
+    };
+    const player_crange home_players = players(home);
+    const player_crange away_players = players(away);
+    const player_crange both_players = players(both);
+    auto home_speed_begin = std::next(speed.begin(), home.first);
+    auto away_speed_begin = std::next(speed.begin(), away.first);
+    auto both_speed_begin = home_speed_begin;
 
-    // if no players in this row, return the previous row
-    std::vector<double> features = default_features();
-    if (row.players.empty()) {
-        this->prev_row = this->curr_row;
-        return features;
+    // if no players in this row, return default features
+    features.assign(num_features(), default_value());
+    if (curr.players.empty()) {
+        return;
     }
 
+    // distances are computed lazily when a statistic needs them
+    workspace.distances.reset(frame);
+
     // Calculate all the features
-    avg_min_max_stats(home_players.first, home_players.second, "home",
-                      features);
-    avg_min_max_stats(away_players.first, away_players.second, "away",
-                      features);
+    avg_min_max_stats(frame, home, Team::home, features);
+    avg_min_max_stats(frame, away, Team::away, features);
 
-    referee_stats(ref_begin, ref_end, ref_speed_it, features);
+    referee_stats(frame, referees, std::next(speed.cbegin(), referees.first),
+                  features);
 
     convex_stats(home_players.first, home_players.second, home_speed_begin,
-                 "home", features);
+                 Team::home, workspace, features);
     convex_stats(away_players.first, away_players.second, away_speed_begin,
-                 "away", features);
-    convex_stats(both_players.first, both_players.second, both_speed_begin,
-                 "player", features);
+                 Team::away, workspace, features);
+    // hull of all the players from the hulls of the teams
+    convex_stats(both_players.first, away_players.first, both_players.second,
+                 both_speed_begin,
+                 workspace.hulls[static_cast<size_t>(Team::home)],
+                 workspace.hulls[static_cast<size_t>(Team::away)],
+                 Team::player, workspace, features);
 
-    distance_stats(home_players.first, home_players.second, "home", features);
-    distance_stats(away_players.first, away_players.second, "away", features);
+    distance_stats(frame, home, Team::home, workspace, features);
+    distance_stats(frame, away, Team::away, workspace, features);
 
-    cluster_stats(both_players.first, both_players.second, "player", features);
-    cluster_stats(home_players.first, home_players.second, "home", features);
-    cluster_stats(away_players.first, away_players.second, "away", features);
+    cluster_stats(both_players.first, both_players.second, Team::player,
+                  workspace, features);
+    cluster_stats(home_players.first, home_players.second, Team::home,
+                  workspace, features);
+    cluster_stats(away_players.first, away_players.second, Team::away,
+                  workspace, features);
 
-    linearity_stats(both_players.first, both_players.second, features);
+    linearity_stats(both_players.first, both_players.second, workspace,
+                    features);
 
-    player_mixing_stats(both_players.first, both_players.second, features);
+    if (!this->warm_start) {
+        player_mixing_stats(both_players.first, both_players.second,
+                            this->restarts, false, workspace, features);
+    }
+}
+
+void Computer::seed_engine(const Row& row, Workspace& workspace) const {
+    // random numbers of a row don't depend on the rows computed before it
+    const uint64_t match_seed = mix_seed(this->seed, row.match_id);
+    workspace.engine.seed(mix_seed(match_seed, row.timestamp));
+}
+
+void Computer::compute_warm_stats(const Row& curr,
+                                  std::vector<double>& features) {
+    if (!this->warm_start) {
+        return;
+    }
 
+    // home and away players follow each other
+    Frame& frame = this->workspace.frame;
+    frame.assign(curr.players.cbegin(), curr.players.cend());
+    const PlayerSpan both = frame.span(PlayerType::home, PlayerType::away);
+    player_cit both_begin = curr.players.cbegin() + both.first;
+    player_cit both_end = curr.players.cbegin() + both.last;
+
+    this->seed_engine(curr, this->workspace);
+    player_mixing_stats(both_begin, both_end, this->restarts, true,
+                        this->workspace, features);
+}
+
+void Computer::fill_missing(std::vector<double>& features) {
     // use the last usable value for features that couldn't be computed
     for (size_t i = 0; i < features.size(); ++i) {
         if (features[i] == feature::default_value()) {
@@ -135,9 +158,109 @@ std::vector<double> Computer::compute_features(const Row& row) {
             this->prev_features[i] = features[i];
         }
     }
+}
+
+std::vector<double> Computer::compute_features(const Row& row) {
+    std::vector<double> features;
+    this->compute_features(row, features);
+    return features;
+}
+
+void Computer::compute_features(const Row& row,
+                                std::vector<double>& features) {
+    if (row.timestamp == this->workspace.player_slots.last_timestamp()) {
+        features = this->prev_features;
+        return;
+    }
+
+    const Row& curr = grouped(row, this->curr_row);
+    this->compute_stats(curr, this->workspace, features);
+
+    // if no players in this row, default features are returned as they are
+    if (!row.players.empty()) {
+        this->compute_warm_stats(curr, features);
+        this->fill_missing(features);
+    }
+}
+
+std::vector<std::vector<double>>
+Computer::compute_features(const std::vector<Row>& rows, ThreadPool& pool) {
+    const size_t num_rows = rows.size();
+    std::vector<std::vector<double>> features(num_rows);
+    if (num_rows == 0) {
+        return features;
+    }
+
+    // find the previous row of each row as in the sequential computation.
+    // Rows with the same timestamp as their previous row are not computed;
+    // num_rows is used as the index of the row last recorded by
+    // this->workspace.
+    std::vector<size_t> prev_index(num_rows);
+    std::vector<bool> computed(num_rows);
+    size_t last = num_rows;
+    long last_timestamp = this->workspace.player_slots.last_timestamp();
+    for (size_t i = 0; i < num_rows; ++i) {
+        computed[i] = rows[i].timestamp != last_timestamp;
+        prev_index[i] = last;
+        if (computed[i]) {
+            last = i;
+            last_timestamp = rows[i].timestamp;
+        }
+    }
 
-    // store the previous row for calculation that require it such as speed
-    this->prev_row = this->curr_row;
+    // compute the statistics of contiguous chunks in parallel
+    const size_t num_chunks = std::min(num_rows, 4 * pool.size());
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(num_chunks);
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        const size_t begin = chunk * num_rows / num_chunks;
+        const size_t end = (chunk + 1) * num_rows / num_chunks;
+        chunks.push_back(pool.submit([this, &rows, &features, &prev_index,
+                                      &computed, begin, end]() {
+            Row buffer;
+            Workspace workspace;
+            workspace.track_hulls = this->track_hulls;
+            if (prev_index[begin] == rows.size()) {
+                workspace.player_slots = this->workspace.player_slots;
+            } else {
+                workspace.player_slots.record(
+                    grouped(rows[prev_index[begin]], buffer));
+            }
+            for (size_t i = begin; i < end; ++i) {
+                if (computed[i]) {
+                    this->compute_stats(grouped(rows[i], buffer), workspace,
+                                        features[i]);
+                }
+            }
+        }));
+    }
+    // wait for all the chunks before rethrowing any exception
+    for (auto& chunk : chunks) {
+        chunk.wait();
+    }
+    for (auto& chunk : chunks) {
+        chunk.get();
+    }
+
+    // compute warm started statistics and fill the missing values
+    // sequentially
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (!computed[i]) {
+            features[i] = this->prev_features;
+        } else if (!rows[i].players.empty()) {
+            if (this->warm_start) {
+                this->compute_warm_stats(grouped(rows[i], this->curr_row),
+                                         features[i]);
+            }
+            this->fill_missing(features[i]);
+        }
+    }
+
+    // record the last row for calculations that require it such as speed
+    if (last != num_rows) {
+        this->workspace.player_slots.record(
+            grouped(rows[last], this->curr_row));
+    }
 
     return features;
 }
@@ -16,12 +16,16 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "constants.hpp"
 #include "row.hpp"
+#include "stats/workspace.hpp"
+
+class ThreadPool;
 
 namespace feature {
 
@@ -31,9 +35,35 @@ namespace feature {
 class Computer {
   public:
     /**
-     * @brief Default constructor.
+     * @brief Construct a Computer whose k-means clusterings are initialized
+     * using the given seed.
+     *
+     * The random number engine is reseeded for every Row using the seed, the
+     * match id and the timestamp of the Row. Hence, the same rows and seed
+     * always give the same features, whether the rows are computed one by one
+     * or in parallel.
+     *
+     * If warm start is enabled, k-means clustering of maxClusterImpurity
+     * starts from the clustering of the previous Row and is restarted from
+     * random initializations only if the clustering gets worse. These
+     * clusterings are computed sequentially in the order of the rows.
+     *
+     * If hull tracking is enabled, the convex hull of each team is repaired
+     * from the hull of the previous Row instead of being built from scratch.
+     * The hulls and the features are the same either way; tracking is meant
+     * for high-rate rows where players move little, e.g. at 10 Hz.
+     *
+     * @param seed_ Seed of the random number engine.
+     * @param warm_start_ Whether to warm start k-means clusterings.
+     * @param restarts_ How many times k-means clusterings are run from random
+     * initializations.
+     * @param track_hulls_ Whether to track the convex hulls of the teams
+     * across rows using details::HullTracker.
      */
-    Computer();
+    explicit Computer(
+        uint64_t seed_ = 0, bool warm_start_ = false,
+        const details::RestartPolicy& restarts_ = details::RestartPolicy(),
+        bool track_hulls_ = false);
 
     /**
      * @brief Compute all the features from a Row object and return them as a
@@ -52,20 +82,117 @@ class Computer {
      */
     std::vector<double> compute_features(const Row& row);
 
+    /**
+     * @brief Same as the function above where the features are written to the
+     * given vector.
+     *
+     * Buffers of this Computer and the given vector are reused; hence, once
+     * they grow to hold the largest Row, features are computed without any
+     * heap allocations.
+     *
+     * @param row Row object representing the current timeframe of the match.
+     * @param features Output vector of doubles containing the features.
+     */
+    void compute_features(const Row& row, std::vector<double>& features);
+
+    /**
+     * @brief Compute the features of consecutive Row objects of a match in
+     * parallel.
+     *
+     * The returned features are exactly the same as the features returned by
+     * calling compute_features(const Row&) for each Row in order, and the
+     * state of this Computer is updated in the same way.
+     *
+     * The statistics of the rows are computed in contiguous chunks on the
+     * workers of the given ThreadPool; each chunk starts from the row
+     * preceding it to calculate speeds. Missing values are then filled with
+     * the most recently computed values in a sequential pass.
+     *
+     * @param rows Consecutive Row objects of a match.
+     * @param pool ThreadPool to compute the chunks on.
+     *
+     * @return Features of each Row in the same order as rows.
+     */
+    std::vector<std::vector<double>>
+    compute_features(const std::vector<Row>& rows, ThreadPool& pool);
+
   private:
     /**
-     * @brief Current row object.
+     * @brief Return the given Row if its players are grouped by their types;
+     * otherwise, copy it into the given buffer, group the players of the copy
+     * using group_by_type and return the copy.
      *
-     * Current row is stored because we must sort Players; hence, we need a
-     * copy.
+     * Rows of the readers are already grouped; hence, they are used without
+     * copying.
+     *
+     * @param row Row to group.
+     * @param buffer Row to copy an ungrouped Row into.
+     *
+     * @return Row whose players are grouped by their types.
      */
-    Row curr_row;
+    static const Row& grouped(const Row& row, Row& buffer);
+
+    /**
+     * @brief Compute all the statistics of a Row without filling the missing
+     * values. Statistics that use warm started k-means clusterings are not
+     * computed.
+     *
+     * @param curr Current Row whose players are grouped by their types.
+     * @param workspace Buffers to reuse. Speeds are calculated using the
+     * previous Row recorded in its PlayerSlots, and the current Row is
+     * recorded. Its random number engine is reseeded for the current Row.
+     * @param features Output features of the current Row. If the current Row
+     * has no players, all the features are feature::default_value().
+     */
+    void compute_stats(const Row& curr, details::Workspace& workspace,
+                       std::vector<double>& features) const;
+
+    /**
+     * @brief Seed the random number engine of the given Workspace for the
+     * given Row.
+     */
+    void seed_engine(const Row& row, details::Workspace& workspace) const;
+
+    /**
+     * @brief Compute the statistics that use warm started k-means
+     * clusterings using the Workspace of this Computer.
+     *
+     * @param curr Current Row whose players are grouped by their types.
+     * @param features Features of the current Row computed by compute_stats.
+     */
+    void compute_warm_stats(const Row& curr, std::vector<double>& features);
+
     /**
-     * @brief Previous row object.
+     * @brief Replace the features that couldn't be computed with the most
+     * recently computed values and store the computed ones.
      *
-     * Previous row is stored to calculate speeds.
+     * @param features Features of a Row that has players.
+     */
+    void fill_missing(std::vector<double>& features);
+
+  private:
+    /**
+     * @brief Seed of the random number engine.
+     */
+    uint64_t seed;
+    /**
+     * @brief Whether k-means clusterings are warm started.
+     */
+    bool warm_start;
+    /**
+     * @brief How many times k-means clusterings are run from random
+     * initializations.
+     */
+    details::RestartPolicy restarts;
+    /**
+     * @brief Whether the convex hulls of the teams are tracked across rows.
+     */
+    bool track_hulls;
+    /**
+     * @brief Buffer to group the players of a Row that is not grouped by
+     * type.
      */
-    Row prev_row;
+    Row curr_row;
     /**
      * @brief Most recently computed features.
      *
@@ -73,6 +200,12 @@ class Computer {
      * timeframe.
      */
     std::vector<double> prev_features;
+    /**
+     * @brief Buffers used to compute the statistics of a Row. Its PlayerSlots
+     * hold the positions of the players of the previous Row to calculate
+     * speeds.
+     */
+    details::Workspace workspace;
 };
 
 }; // namespace feature
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <stdexcept>
 
 #include "constants.hpp"
 #include <utils.hpp>
@@ -23,52 +24,17 @@
 namespace feature {
 
 std::vector<std::string> feature_list() {
-    return {
-        "awayAvgX",
-        "awayAvgY",
-        "awayConvexCenterX",
-        "awayConvexCenterY",
-        "awayConvexClosestDistance",
-        "awayConvexFarDistance",
-        "awayConvexMaxSpeed",
-        "awayConvexMaxX",
-        "awayConvexMaxY",
-        "awayConvexMinX",
-        "awayConvexMinY",
-        "awayDenseClusterDensity",
-        "awayInnerDistance",
-        "awaySparseClusterDensity",
-        "homeAvgX",
-        "homeAvgY",
-        "homeConvexCenterX",
-        "homeConvexCenterY",
-        "homeConvexClosestDistance",
-        "homeConvexFarDistance",
-        "homeConvexMaxSpeed",
-        "homeConvexMaxX",
-        "homeConvexMaxY",
-        "homeConvexMinX",
-        "homeConvexMinY",
-        "homeDenseClusterDensity",
-        "homeInnerDistance",
-        "homeSparseClusterDensity",
-        "maxClusterImpurity",
-        "playerConvexCenterX",
-        "playerConvexCenterY",
-        "playerConvexClosestDistance",
-        "playerConvexFarDistance",
-        "playerConvexMaxSpeed",
-        "playerConvexMaxX",
-        "playerConvexMaxY",
-        "playerConvexMinX",
-        "playerConvexMinY",
-        "playerDenseClusterDensity",
-        "playerSparseClusterDensity",
-        "playerVerticalLinearity",
-        "refSpeed",
-        "refX",
-        "refY",
-    };
+    return std::vector<std::string>(std::begin(details::feature_names),
+                                    std::end(details::feature_names));
+}
+
+Team prefix_to_team(const std::string& prefix) {
+    for (int t = 0; t < static_cast<int>(Team::count); ++t) {
+        if (prefix == details::team_prefixes[t]) {
+            return static_cast<Team>(t);
+        }
+    }
+    throw std::out_of_range("Unknown team prefix: " + prefix);
 }
 
 double default_value() { return -1; }
@@ -145,10 +111,7 @@ const std::string& index_to_name(const int index) {
     return nmap->at(index);
 }
 
-size_t num_features() {
-    static size_t size = feature_list().size();
-    return size;
-}
+size_t num_features() { return details::feature_count; }
 
 int player_name_to_type(const std::string& name) {
     // build the map only once
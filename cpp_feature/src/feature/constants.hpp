@@ -21,8 +21,21 @@
 #include <utility>
 #include <vector>
 
+#include <small_vector.hpp>
+
 #include "player.hpp"
 
+#ifndef FEATURE_INLINE_PLAYERS
+/**
+ * @brief Number of players a player_seq holds without allocating memory.
+ *
+ * A frame holds about 25 players and referees. Frames with more players are
+ * still supported; their players are moved to the heap. The value can be
+ * changed with the INLINE_PLAYERS cmake option.
+ */
+#define FEATURE_INLINE_PLAYERS 32
+#endif
+
 /**
  * @brief Namespace for classes and functions related to feature computation.
  */
@@ -46,8 +59,11 @@ typedef std::unordered_map<int, std::string> index_to_name_map;
 
 /**
  * @brief Typedef for sequence of Player objects.
+ *
+ * Players are stored inside the sequence up to FEATURE_INLINE_PLAYERS
+ * players; hence, copying a Row doesn't allocate memory.
  */
-typedef std::vector<Player> player_seq;
+typedef SmallVector<Player, FEATURE_INLINE_PLAYERS> player_seq;
 /**
  * @brief Typedef for Player iterator
  */
@@ -65,6 +81,274 @@ typedef std::pair<player_it, player_it> player_range;
  */
 typedef std::pair<player_cit, player_cit> player_crange;
 
+/**
+ * @brief Player types as stored in Player::type.
+ *
+ * Values are the same as the ones returned by player_name_to_type. count is
+ * the number of the types and not a type itself.
+ */
+enum class PlayerType : int {
+    home = 0,
+    away = 1,
+    referee = 2,
+    home_gk = 3,
+    away_gk = 4,
+    count
+};
+
+/**
+ * @brief Group of players a family of features is computed for.
+ *
+ * Each team is the prefix of the names of the features computed for it.
+ */
+enum class Team : int { home, away, player, count };
+
+/**
+ * @brief Family of features that is computed for each Team.
+ *
+ * Each family is the suffix of the names of the features of that family.
+ */
+enum class Stat : int {
+    AvgX,
+    AvgY,
+    ConvexCenterX,
+    ConvexCenterY,
+    ConvexClosestDistance,
+    ConvexFarDistance,
+    ConvexMaxSpeed,
+    ConvexMaxX,
+    ConvexMaxY,
+    ConvexMinX,
+    ConvexMinY,
+    DenseClusterDensity,
+    InnerDistance,
+    SparseClusterDensity,
+    VerticalLinearity,
+    count
+};
+
+namespace details {
+
+/**
+ * @brief Names of all the features in sorted order.
+ *
+ * The index of a feature name in this table is the ID of that feature.
+ */
+constexpr const char* feature_names[] = {
+    "awayAvgX",
+    "awayAvgY",
+    "awayConvexCenterX",
+    "awayConvexCenterY",
+    "awayConvexClosestDistance",
+    "awayConvexFarDistance",
+    "awayConvexMaxSpeed",
+    "awayConvexMaxX",
+    "awayConvexMaxY",
+    "awayConvexMinX",
+    "awayConvexMinY",
+    "awayDenseClusterDensity",
+    "awayInnerDistance",
+    "awaySparseClusterDensity",
+    "homeAvgX",
+    "homeAvgY",
+    "homeConvexCenterX",
+    "homeConvexCenterY",
+    "homeConvexClosestDistance",
+    "homeConvexFarDistance",
+    "homeConvexMaxSpeed",
+    "homeConvexMaxX",
+    "homeConvexMaxY",
+    "homeConvexMinX",
+    "homeConvexMinY",
+    "homeDenseClusterDensity",
+    "homeInnerDistance",
+    "homeSparseClusterDensity",
+    "maxClusterImpurity",
+    "playerConvexCenterX",
+    "playerConvexCenterY",
+    "playerConvexClosestDistance",
+    "playerConvexFarDistance",
+    "playerConvexMaxSpeed",
+    "playerConvexMaxX",
+    "playerConvexMaxY",
+    "playerConvexMinX",
+    "playerConvexMinY",
+    "playerDenseClusterDensity",
+    "playerSparseClusterDensity",
+    "playerVerticalLinearity",
+    "refSpeed",
+    "refX",
+    "refY",
+};
+
+/**
+ * @brief Number of features.
+ */
+constexpr int feature_count =
+    sizeof(feature_names) / sizeof(feature_names[0]);
+
+/**
+ * @brief Name prefixes of the teams in the order of Team.
+ */
+constexpr const char* team_prefixes[] = {"home", "away", "player"};
+
+/**
+ * @brief Name suffixes of the feature families in the order of Stat.
+ */
+constexpr const char* stat_suffixes[] = {
+    "AvgX",
+    "AvgY",
+    "ConvexCenterX",
+    "ConvexCenterY",
+    "ConvexClosestDistance",
+    "ConvexFarDistance",
+    "ConvexMaxSpeed",
+    "ConvexMaxX",
+    "ConvexMaxY",
+    "ConvexMinX",
+    "ConvexMinY",
+    "DenseClusterDensity",
+    "InnerDistance",
+    "SparseClusterDensity",
+    "VerticalLinearity",
+};
+
+/**
+ * @brief Compare the concatenation of prefix and suffix with name in
+ * lexicographical order like std::strcmp.
+ *
+ * @return A negative value if prefix + suffix is less than name, 0 if they are
+ * equal and a positive value otherwise.
+ */
+constexpr int compare_name(const char* prefix, const char* suffix,
+                           const char* name) {
+    for (; *prefix != '\0'; ++prefix, ++name) {
+        if (*prefix != *name) {
+            return (*prefix < *name) ? -1 : 1;
+        }
+    }
+    for (; *suffix != '\0'; ++suffix, ++name) {
+        if (*suffix != *name) {
+            return (*suffix < *name) ? -1 : 1;
+        }
+    }
+    return (*name == '\0') ? 0 : -1;
+}
+
+/**
+ * @brief Find the ID of the feature whose name is prefix + suffix using binary
+ * search in feature_names.
+ *
+ * @return ID of the feature, or -1 if there is no such feature.
+ */
+constexpr int find_feature(const char* prefix, const char* suffix = "") {
+    int low = 0;
+    int high = feature_count;
+    while (low < high) {
+        const int mid = (low + high) / 2;
+        const int cmp = compare_name(prefix, suffix, feature_names[mid]);
+        if (cmp == 0) {
+            return mid;
+        }
+        if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Check whether feature_names is strictly sorted.
+ */
+constexpr bool feature_names_sorted() {
+    for (int i = 1; i < feature_count; ++i) {
+        if (compare_name(feature_names[i - 1], "", feature_names[i]) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(feature_names_sorted(),
+              "feature_names must be sorted for binary search");
+
+/**
+ * @brief IDs of the features of each Team and Stat pair.
+ */
+struct FeatureIndexTable {
+    /**
+     * @brief ID of the feature of team t and family s is stored at
+     * indices[t][s]; -1 if no such feature exists.
+     */
+    int indices[static_cast<int>(Team::count)][static_cast<int>(Stat::count)];
+};
+
+/**
+ * @brief Construct the FeatureIndexTable at compile time.
+ */
+constexpr FeatureIndexTable make_feature_index_table() {
+    FeatureIndexTable table{};
+    for (int t = 0; t < static_cast<int>(Team::count); ++t) {
+        for (int s = 0; s < static_cast<int>(Stat::count); ++s) {
+            table.indices[t][s] =
+                find_feature(team_prefixes[t], stat_suffixes[s]);
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief IDs of the features of each Team and Stat pair.
+ */
+constexpr FeatureIndexTable feature_index_table = make_feature_index_table();
+
+}; // namespace details
+
+/**
+ * @brief Return the ID of the feature of the given family computed for the
+ * given team.
+ *
+ * The ID is the same as name_to_index(prefix + suffix) and is looked up in a
+ * table built at compile time.
+ *
+ * @param team Team of the feature.
+ * @param stat Family of the feature.
+ *
+ * @return ID of the feature, or -1 if the feature is not computed for the
+ * given team.
+ */
+constexpr int feature_index(Team team, Stat stat) {
+    return details::feature_index_table
+        .indices[static_cast<int>(team)][static_cast<int>(stat)];
+}
+
+/**
+ * @brief IDs of the features that are not computed per Team.
+ */
+enum FeatureId : int {
+    max_cluster_impurity_id = details::find_feature("maxClusterImpurity"),
+    ref_speed_id = details::find_feature("refSpeed"),
+    ref_x_id = details::find_feature("refX"),
+    ref_y_id = details::find_feature("refY"),
+};
+
+static_assert(max_cluster_impurity_id >= 0 && ref_speed_id >= 0 &&
+                  ref_x_id >= 0 && ref_y_id >= 0,
+              "All FeatureId values must be in feature_names");
+
+/**
+ * @brief Return the Team whose name prefix is the given string.
+ *
+ * @param prefix Name prefix of the team (home/away/player).
+ *
+ * @return Team with the given prefix.
+ *
+ * @throws std::out_of_range if there is no such team.
+ */
+Team prefix_to_team(const std::string& prefix);
+
 /**
  * @brief Return a list of feature names.
  *
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iterator>
+#include <stdexcept>
+
+#include <pairwise_distance.hpp>
+
+#include "frame.hpp"
+#include "row.hpp"
+
+namespace feature {
+
+void Frame::assign(player_cit begin, player_cit end) {
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+
+    // padding lets the kernels read whole vectors from any span
+    this->xs.assign(n + pairwise_lanes, 0);
+    this->ys.assign(n + pairwise_lanes, 0);
+    this->ids.resize(n);
+
+    // group g starts at the first player whose group is not less than g
+    size_t group = 0;
+    this->offsets[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const Player& p = begin[i];
+        const size_t player_group = type_group(p.type);
+        if (player_group < group) {
+            throw std::runtime_error("Players are not grouped by type");
+        }
+        while (group < player_group) {
+            this->offsets[++group] = i;
+        }
+        this->xs[i] = p.x;
+        this->ys[i] = p.y;
+        this->ids[i] = p.id;
+    }
+    while (group + 1 < this->offsets.size()) {
+        this->offsets[++group] = n;
+    }
+}
+
+}; // namespace feature
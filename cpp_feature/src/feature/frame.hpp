@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <utils.hpp>
+
+#include "constants.hpp"
+
+namespace feature {
+
+/**
+ * @brief Range [first, last) of the player indices of a Frame.
+ */
+struct PlayerSpan {
+    /**
+     * @brief Index of the first player.
+     */
+    size_t first;
+    /**
+     * @brief Index one past the last player.
+     */
+    size_t last;
+
+    /**
+     * @brief Return the number of players in the span.
+     */
+    size_t size() const { return this->last - this->first; }
+
+    /**
+     * @brief Return true if there are no players in the span.
+     */
+    bool empty() const { return this->first == this->last; }
+};
+
+/**
+ * @brief Frame holds the players of a timeframe in structure of arrays
+ * layout.
+ *
+ * Coordinates and ids of the players are stored in contiguous arrays aligned
+ * to simd_alignment. Players are grouped by their types as in group_by_type;
+ * hence, players of each PlayerType form a PlayerSpan found without any
+ * search. The coordinate arrays can be read pairwise_lanes elements past the
+ * end of any span; e.g. x() + span.first and y() + span.first can be given to
+ * pairwise_distance_sum directly.
+ *
+ * Once the arrays have grown to the number of players, no memory is
+ * allocated.
+ */
+class Frame {
+  public:
+    /**
+     * @brief Store the given players in this Frame.
+     *
+     * Index i of the Frame is the player begin[i].
+     *
+     * @param begin Beginning of the Player range [begin, end), grouped by
+     * type.
+     * @param end End of the Player range [begin, end).
+     *
+     * @throws std::runtime_error if the players aren't grouped by type.
+     */
+    void assign(player_cit begin, player_cit end);
+
+    /**
+     * @brief Return the number of players.
+     */
+    size_t size() const { return this->ids.size(); }
+
+    /**
+     * @brief Return the x coordinates of the players.
+     */
+    const double* x() const { return this->xs.data(); }
+
+    /**
+     * @brief Return the y coordinates of the players.
+     */
+    const double* y() const { return this->ys.data(); }
+
+    /**
+     * @brief Return the ids of the players.
+     */
+    const int* id() const { return this->ids.data(); }
+
+    /**
+     * @brief Return the span of the players of the given type.
+     */
+    PlayerSpan span(PlayerType type) const {
+        const size_t group = static_cast<size_t>(type);
+        return {this->offsets[group], this->offsets[group + 1]};
+    }
+
+    /**
+     * @brief Return the span of the players of the types from first to last,
+     * both inclusive, which follow each other; e.g. home and away players.
+     */
+    PlayerSpan span(PlayerType first, PlayerType last) const {
+        return {this->span(first).first, this->span(last).last};
+    }
+
+  private:
+    /**
+     * @brief x coordinates followed by the padding.
+     */
+    aligned_vector<double> xs;
+    /**
+     * @brief y coordinates followed by the padding.
+     */
+    aligned_vector<double> ys;
+    /**
+     * @brief Player ids.
+     */
+    aligned_vector<int> ids;
+    /**
+     * @brief Index of the first player of each group of type_group, followed
+     * by the number of players.
+     */
+    std::array<size_t, static_cast<size_t>(PlayerType::count) + 2> offsets;
+};
+
+}; // namespace feature
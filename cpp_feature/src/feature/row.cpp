@@ -30,6 +30,32 @@ bool operator==(const Row& r1, const Row& r2) {
 
 bool operator!=(const Row& r1, const Row& r2) { return !(r1 == r2); }
 
+bool grouped_by_type(const player_seq& players) {
+    for (size_t i = 1; i < players.size(); ++i) {
+        if (type_group(players[i].type) < type_group(players[i - 1].type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void group_by_type(player_seq& players) {
+    // insertion sort is stable, in-place and linear for grouped players
+    for (size_t i = 1; i < players.size(); ++i) {
+        const size_t group = type_group(players[i].type);
+        if (group >= type_group(players[i - 1].type)) {
+            continue;
+        }
+        Player player = players[i];
+        size_t j = i;
+        while (j > 0 && group < type_group(players[j - 1].type)) {
+            players[j] = players[j - 1];
+            --j;
+        }
+        players[j] = player;
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const Row& r) {
     os << "Row(match_id=" << r.match_id << ", "
        << "timestamp=" << r.timestamp << ", "
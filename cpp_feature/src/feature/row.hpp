@@ -87,6 +87,36 @@ bool operator==(const Row& p1, const Row& p2);
  */
 bool operator!=(const Row& p1, const Row& p2);
 
+/**
+ * @brief Return the group of the given Player::type when players are grouped
+ * by their types.
+ *
+ * Each PlayerType is its own group, in the order of their values. Players of
+ * any other type form the last group, PlayerType::count.
+ */
+inline size_t type_group(int type) {
+    return (type >= 0 && type < static_cast<int>(PlayerType::count))
+               ? static_cast<size_t>(type)
+               : static_cast<size_t>(PlayerType::count);
+}
+
+/**
+ * @brief Return true if the given players are grouped by their types; i.e.
+ * type_group of the players never decreases.
+ */
+bool grouped_by_type(const player_seq& players);
+
+/**
+ * @brief Group the given players by their types in-place.
+ *
+ * Players are ordered with respect to type_group and the order of the players
+ * in the same group is preserved. Grouping takes linear time if the players
+ * are already grouped and doesn't allocate memory.
+ *
+ * @param players Players to group in-place.
+ */
+void group_by_type(player_seq& players);
+
 /**
  * @brief Output stream operator for Row objects.
  *
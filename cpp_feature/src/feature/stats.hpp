@@ -24,3 +24,4 @@
 #include "stats/player_mixing_stats.hpp"
 #include "stats/referee_stats.hpp"
 #include "stats/speed.hpp"
+#include "stats/workspace.hpp"
@@ -25,8 +25,7 @@
 namespace feature {
 namespace details {
 
-void avg_min_max_stats(player_cit begin, player_cit end,
-                       const std::string& prefix,
+void avg_min_max_stats(player_cit begin, player_cit end, Team team,
                        std::vector<double>& features) {
     double avg_x = 0, avg_y = 0;
     double size = static_cast<double>(std::distance(begin, end));
@@ -44,8 +43,35 @@ void avg_min_max_stats(player_cit begin, player_cit end,
         avg_y += y / size;
     }
 
-    features[name_to_index(prefix + "AvgX")] = avg_x;
-    features[name_to_index(prefix + "AvgY")] = avg_y;
+    features[feature_index(team, Stat::AvgX)] = avg_x;
+    features[feature_index(team, Stat::AvgY)] = avg_y;
+}
+
+void avg_min_max_stats(const Frame& frame, PlayerSpan span, Team team,
+                       std::vector<double>& features) {
+    double avg_x = 0, avg_y = 0;
+    double size = static_cast<double>(span.size());
+
+    // if no players
+    if (span.empty()) {
+        avg_x = avg_y = feature::default_value();
+    }
+
+    const double* x = frame.x();
+    const double* y = frame.y();
+    for (size_t i = span.first; i < span.last; ++i) {
+        avg_x += x[i] / size;
+        avg_y += y[i] / size;
+    }
+
+    features[feature_index(team, Stat::AvgX)] = avg_x;
+    features[feature_index(team, Stat::AvgY)] = avg_y;
+}
+
+void avg_min_max_stats(player_cit begin, player_cit end,
+                       const std::string& prefix,
+                       std::vector<double>& features) {
+    avg_min_max_stats(begin, end, prefix_to_team(prefix), features);
 }
 
 }; // namespace details
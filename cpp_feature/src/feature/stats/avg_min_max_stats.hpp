@@ -20,6 +20,7 @@
 #include <vector>
 
 #include <feature/constants.hpp>
+#include <feature/frame.hpp>
 
 namespace feature {
 namespace details {
@@ -29,11 +30,24 @@ namespace details {
  *
  * @param begin Beginning of Player range [begin, end).
  * @param end End of Player range [begin, end).
- * @param prefix Prefix of the feature name. If prefix == "home", then the
- * calculated feature will be written to the index designated to
- * homeInnerDistance. Must be one of "home", "away" or "player".
+ * @param team Team of the players. Features are written to the indices of
+ * this team; e.g. if team == Team::home, homeInnerDistance is written.
  * @param features features vector to write the calculated feature in-place.
  */
+void avg_min_max_stats(player_cit begin, player_cit end, Team team,
+                       std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the players are given by a
+ * PlayerSpan of a Frame.
+ */
+void avg_min_max_stats(const Frame& frame, PlayerSpan span, Team team,
+                       std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the team is given by its name
+ * prefix ("home", "away" or "player").
+ */
 void avg_min_max_stats(player_cit begin, player_cit end,
                        const std::string& prefix,
                        std::vector<double>& features);
@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 
-#include <dkm/dkm.hpp>
 #include <iostream>
+#include <stdexcept>
 
 #include "cluster_stats.hpp"
 #include "dkm_utils.hpp"
@@ -23,8 +23,8 @@
 namespace feature {
 namespace details {
 
-void cluster_stats(player_cit begin, player_cit end, const std::string& prefix,
-                   std::vector<double>& features) {
+void cluster_stats(player_cit begin, player_cit end, Team team,
+                   Workspace& workspace, std::vector<double>& features) {
     constexpr int n_clusters = 2;
     // density of the two clusters
     std::pair<double, double> densities{feature::default_value(),
@@ -32,43 +32,59 @@ void cluster_stats(player_cit begin, player_cit end, const std::string& prefix,
 
     // at least n_clusters many players
     if (std::distance(begin, end) >= n_clusters) {
-        // calculate clustering
-        dkm_point_seq<2> points = players_to_points(begin, end);
-        dkm_means<2> means = kmeans(points, n_clusters);
+        // calculate the optimal clustering
+        players_to_points(begin, end, workspace.points);
+        workspace.two_means.fit(workspace.points);
 
-        densities = cluster_densities(means, points);
+        densities = cluster_densities(workspace.two_means.centroids(),
+                                      workspace.two_means.point_labels(),
+                                      workspace.points);
     }
 
-    features[name_to_index(prefix + "DenseClusterDensity")] = densities.first;
-    features[name_to_index(prefix + "SparseClusterDensity")] = densities.second;
+    features[feature_index(team, Stat::DenseClusterDensity)] = densities.first;
+    features[feature_index(team, Stat::SparseClusterDensity)] = densities.second;
+}
+
+void cluster_stats(player_cit begin, player_cit end, const std::string& prefix,
+                   std::vector<double>& features) {
+    Workspace workspace;
+    cluster_stats(begin, end, prefix_to_team(prefix), workspace, features);
 }
 
 std::pair<double, double> cluster_densities(const dkm_means<2>& means,
                                             const dkm_point_seq<2>& points) {
-    // destructure the clustering
-    dkm_point_seq<2> centroids;
-    dkm_label_seq labels;
-    std::tie(centroids, labels) = means;
+    return cluster_densities(std::get<0>(means), std::get<1>(means), points);
+}
+
+std::pair<double, double> cluster_densities(const dkm_point_seq<2>& centroids,
+                                            const dkm_label_seq& labels,
+                                            const dkm_point_seq<2>& points) {
+    if (points.size() != labels.size())
+        throw std::runtime_error("points and labels have different sizes");
 
     double max_density = std::numeric_limits<double>::lowest();
     double min_density = std::numeric_limits<double>::max();
 
     // for each cluster
     for (uint32_t curr_label = 0; curr_label < centroids.size(); ++curr_label) {
-        // Center and points of the current cluster
-        dkm_point<2> center = centroids[curr_label];
-        dkm_point_seq<2> cluster = get_cluster(points, labels, curr_label);
+        // Center of the current cluster
+        const dkm_point<2>& center = centroids[curr_label];
+
+        // size of the cluster and the largest distance of a point in the
+        // cluster to the cluster center
+        size_t cluster_size = 0;
+        double max_dist = std::numeric_limits<double>::lowest();
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (labels[i] == curr_label) {
+                ++cluster_size;
+                max_dist = std::max(max_dist, dist<2>(points[i], center));
+            }
+        }
 
-        if (cluster.empty()) {
+        if (cluster_size == 0) {
             continue;
         }
 
-        // distance of each point in the cluster to the cluster center
-        std::vector<double> diff(cluster.size(), 0);
-        dist_to_center(cluster, center, diff.begin());
-
-        double max_dist = *std::max_element(diff.begin(), diff.end());
-
         // true if there is some distance between players in the cluster
         bool distant_players = !close(max_dist, 0);
 
@@ -77,7 +93,7 @@ std::pair<double, double> cluster_densities(const dkm_means<2>& means,
 
         // if there is no distance between any players, don't use this cluster
         if (distant_players) {
-            density = cluster.size() / max_dist;
+            density = cluster_size / max_dist;
         }
         max_density = std::max(max_density, density);
         min_density = std::min(min_density, density);
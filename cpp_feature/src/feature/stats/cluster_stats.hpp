@@ -24,6 +24,7 @@
 #include <utils.hpp>
 
 #include "dkm_utils.hpp"
+#include "workspace.hpp"
 
 namespace feature {
 namespace details {
@@ -32,15 +33,24 @@ namespace details {
  * @brief Calculate features related to the clustering of players.
  *
  * This function calculates DenseClusterDensity and SparseClusterDensity
- * features for the Players in the given range [begin, end).
+ * features for the Players in the given range [begin, end). Players are
+ * clustered using the optimal 2-means clustering computed by TwoMeans; hence,
+ * the features don't change between runs.
  *
  * @param begin Beginning of Player range [begin, end).
  * @param end End of Player range [begin, end).
- * @param prefix Prefix of the feature name. If prefix == "home", then the
- * calculated feature will be written to the index designated to
- * homeInnerDistance. Must be one of "home", "away" or "player".
+ * @param team Team of the players. Features are written to the indices of
+ * this team; e.g. if team == Team::home, homeInnerDistance is written.
+ * @param workspace Buffers to reuse.
  * @param features features vector to write the calculated feature in-place.
  */
+void cluster_stats(player_cit begin, player_cit end, Team team,
+                   Workspace& workspace, std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the team is given by its name
+ * prefix ("home", "away" or "player") and a new Workspace is used.
+ */
 void cluster_stats(player_cit begin, player_cit end, const std::string& prefix,
                    std::vector<double>& features);
 
@@ -56,5 +66,13 @@ void cluster_stats(player_cit begin, player_cit end, const std::string& prefix,
 std::pair<double, double> cluster_densities(const dkm_means<2>& means,
                                             const dkm_point_seq<2>& points);
 
+/**
+ * @brief Same as the function above where the clustering is given as
+ * separate centroids and labels. No memory is allocated.
+ */
+std::pair<double, double> cluster_densities(const dkm_point_seq<2>& centroids,
+                                            const dkm_label_seq& labels,
+                                            const dkm_point_seq<2>& points);
+
 }; // namespace details
 }; // namespace feature
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <feature/constants.hpp>
+#include <feature/player.hpp>
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief Return the z component of the cross product of vectors OA and OB.
+ *
+ * The result is positive if O, A, B make a counter-clockwise turn, negative if
+ * they make a clockwise turn and 0 if they are collinear.
+ */
+inline double cross(const Player& o, const Player& a, const Player& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+/**
+ * @brief Compare two players of a range by their coordinates and then by
+ * their indices.
+ */
+inline bool position_less(player_cit begin, int i, int j) {
+    const Player& p = begin[i];
+    const Player& q = begin[j];
+    if (p.x != q.x)
+        return p.x < q.x;
+    if (p.y != q.y)
+        return p.y < q.y;
+    return i < j;
+}
+
+/**
+ * @brief Find the convex hull of the players given by their indices sorted
+ * with position_less using Andrew's monotone chain algorithm in \f$O(N)\f$
+ * time.
+ *
+ * The hull is as described in convex_hull. All but the first of the players at
+ * the same position are removed from order.
+ *
+ * @param begin Beginning of the player range.
+ * @param order Sorted indices of the players.
+ * @param hull Output indices of the players on the convex hull. If order is
+ * empty, hull is empty.
+ */
+inline void monotone_chain(player_cit begin, std::vector<int>& order,
+                           std::vector<int>& hull) {
+    if (order.empty()) {
+        hull.clear();
+        return;
+    }
+
+    // keep only the first player at each position
+    auto same_position = [begin](int i, int j) {
+        return begin[i].x == begin[j].x && begin[i].y == begin[j].y;
+    };
+    order.erase(std::unique(order.begin(), order.end(), same_position),
+                order.end());
+    const int m = static_cast<int>(order.size());
+
+    // upper chain from left to right and lower chain from right to left,
+    // keeping only clockwise turns
+    hull.resize(2 * m);
+    int k = 0;
+    for (int i = 0; i < m; ++i) {
+        while (k >= 2 && cross(begin[hull[k - 2]], begin[hull[k - 1]],
+                               begin[order[i]]) >= 0) {
+            --k;
+        }
+        hull[k++] = order[i];
+    }
+    for (int i = m - 2, t = k + 1; i >= 0; --i) {
+        while (k >= t && cross(begin[hull[k - 2]], begin[hull[k - 1]],
+                               begin[order[i]]) >= 0) {
+            --k;
+        }
+        hull[k++] = order[i];
+    }
+    // last point is the same as the first one
+    hull.resize(k - 1);
+
+    // degenerate hull of collinear points
+    if (hull.size() < 3) {
+        const int first = order.front();
+        const int last = order.back();
+        hull.assign({first, last, first});
+    }
+}
+
+/**
+ * @brief Find the convex hull of a Player range [begin, end) and write the
+ * indices of Player objects that are on the convex hull.
+ *
+ * The hull is computed using Andrew's monotone chain algorithm in
+ * \f$O(NlogN)\f$ time on the indices of the players; hence, each hull vertex
+ * is known by its index without searching for its coordinates. The hull
+ * starts at the lexicographically smallest point and goes in clockwise order;
+ * collinear points and all but the first of the players at the same position
+ * are not on the hull. If all the players are collinear, the hull is the two
+ * end points a and b given as [a, b, a]. This is the same hull computed by
+ * boost::geometry::convex_hull.
+ *
+ * No memory is allocated if the given buffers are large enough.
+ *
+ * @param begin Beginning of the player range [begin, end).
+ * @param end End of the player range [begin, end).
+ * @param order Buffer to sort the indices of the players.
+ * @param hull Output indices of the players on the convex hull. If the range
+ * is empty, hull is empty.
+ */
+inline void convex_hull(player_cit begin, player_cit end,
+                        std::vector<int>& order, std::vector<int>& hull) {
+    const int n = static_cast<int>(std::distance(begin, end));
+
+    // sort the players by their coordinates
+    order.resize(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [begin](int i, int j) {
+        return position_less(begin, i, j);
+    });
+
+    monotone_chain(begin, order, hull);
+}
+
+/**
+ * @brief Append the distinct vertices of a convex hull computed by
+ * convex_hull to the given sequence in the order of position_less.
+ *
+ * The hull starts with the upper chain in increasing order and continues with
+ * the lower chain in decreasing order; hence, the vertices are sorted by
+ * merging the two chains in \f$O(H)\f$ time.
+ *
+ * @param begin Beginning of the player range.
+ * @param hull Indices of the players on the convex hull relative to
+ * begin + offset.
+ * @param offset Offset to add to each index in hull.
+ * @param sorted Output sequence to append the indices relative to begin.
+ */
+inline void append_sorted_vertices(player_cit begin,
+                                   const std::vector<int>& hull, int offset,
+                                   std::vector<int>& sorted) {
+    // the first vertex is repeated at the end of degenerate hulls
+    if (hull.empty()) {
+        return;
+    }
+    size_t size = hull.size();
+    while (size > 1 && hull[size - 1] == hull[0]) {
+        --size;
+    }
+    auto less = [begin, offset](int i, int j) {
+        return position_less(begin, i + offset, j + offset);
+    };
+
+    // end of the upper chain
+    size_t upper = 1;
+    while (upper < size && less(hull[upper - 1], hull[upper])) {
+        ++upper;
+    }
+
+    // merge the upper chain with the reversed lower chain
+    size_t i = 0;
+    size_t j = size;
+    while (i < upper || j > upper) {
+        if (j == upper || (i < upper && less(hull[i], hull[j - 1]))) {
+            sorted.push_back(hull[i++] + offset);
+        } else {
+            sorted.push_back(hull[--j] + offset);
+        }
+    }
+}
+
+/**
+ * @brief Find the convex hull of the union of two consecutive Player ranges
+ * [begin, middle) and [middle, end) from their convex hulls.
+ *
+ * Only the vertices of the two hulls can be on the hull of their union.
+ * Vertices of each hull are sorted in linear time and merged, and the hull of
+ * the union is found using monotone_chain in \f$O(H_1 + H_2)\f$ time. The
+ * result is the same as convex_hull(begin, end, order, hull).
+ *
+ * No memory is allocated if the given buffers are large enough.
+ *
+ * @param begin Beginning of the first player range [begin, middle).
+ * @param middle End of the first and beginning of the second player range
+ * [middle, end).
+ * @param first_hull Convex hull of the first range computed by convex_hull.
+ * @param second_hull Convex hull of the second range computed by
+ * convex_hull; its indices are relative to middle.
+ * @param vertices Buffer to sort the vertices of each hull.
+ * @param order Buffer to merge the sorted vertices.
+ * @param hull Output indices of the players on the convex hull of [begin,
+ * end) relative to begin.
+ */
+inline void merge_hulls(player_cit begin, player_cit middle,
+                        const std::vector<int>& first_hull,
+                        const std::vector<int>& second_hull,
+                        std::vector<int>& vertices, std::vector<int>& order,
+                        std::vector<int>& hull) {
+    const int offset = static_cast<int>(std::distance(begin, middle));
+    vertices.clear();
+    append_sorted_vertices(begin, first_hull, 0, vertices);
+    const auto first_end = static_cast<std::ptrdiff_t>(vertices.size());
+    append_sorted_vertices(begin, second_hull, offset, vertices);
+
+    order.resize(vertices.size());
+    std::merge(vertices.begin(), vertices.begin() + first_end,
+               vertices.begin() + first_end, vertices.end(), order.begin(),
+               [begin](int i, int j) { return position_less(begin, i, j); });
+
+    monotone_chain(begin, order, hull);
+}
+
+/**
+ * @brief Same as the function above where the indices of the players on the
+ * convex hull are returned.
+ */
+inline std::vector<int> convex_hull(player_cit begin, player_cit end) {
+    std::vector<int> order;
+    std::vector<int> hull;
+    convex_hull(begin, end, order, hull);
+    return hull;
+}
+
+}; // namespace details
+}; // namespace feature
@@ -16,101 +16,23 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/multi_point.hpp>
-#include <boost/geometry/geometries/point.hpp>
-
+#include "convex_hull.hpp"
 #include "convex_stats.hpp"
 #include <utils.hpp>
 
-using namespace feature;
-
-namespace bg = boost::geometry;
-typedef bg::model::point<double, 2, bg::cs::cartesian> point;
-typedef bg::model::multi_point<point> multi_point;
-
-/**
- * Find the convex hull of Player sequence between [begin, end) and return the
- * indices of Player objects that are on the convex hull.
- */
-/**
- * @brief Find the convex hull of a Player range [begin, end) and return the
- * indices of Player objects that are on the convex hull.
- *
- * This function computes the convex hull of Player objects given in [begin,
- * end) and then finds the indices of points on the hull by doing an \f$O(NK)\f$
- * time worst-case search where \f$K\f$ is the size of the convex hull and
- * \f$N\f$ is the number of total players.
- *
- * @param begin Beginning of the player range [begin, end).
- * @param end End of the player range [begin, end).
- *
- * @return Indices of the players on the convex hull.
- *
- * @todo Reduce index finding time complexity to \f$O(KlogN)\f$ by sorting the
- * points. We should do this if \f$NK \gg KlogN\f$ which is not the case for
- * small \f$N\f$.
- */
-static std::vector<int> convex_indices(player_cit begin, player_cit end) {
-    // construct points
-    multi_point points;
-    for (auto it = begin; it != end; ++it) {
-        bg::append(points, point(it->x, it->y));
-    }
-    // compute convex hull
-    multi_point hull;
-    bg::convex_hull(points, hull);
-
-    // find the index of each point on the hull by searching for it in the
-    // original range.
-    std::vector<int> indices;
-    // bg::convex_hull puts the first point twice. Don't count it in the end.
-    for (auto it = boost::begin(hull); it != std::prev(boost::end(hull));
-         ++it) {
-        auto point_it = std::find_if(
-            boost::begin(points), boost::end(points), [it](const point& p) {
-                return close(p.get<0>(), it->get<0>()) &&
-                       close(p.get<1>(), it->get<1>());
-            });
-        indices.push_back(std::distance(boost::begin(points), point_it));
-    }
-
-    return indices;
-}
-
-/**
- * Constructs a sequence of Point objects from Player objects at the given
- * indices of the given Player sequence starting at begin.
- */
-
-/**
- * @brief Construct a vector of point types at the given indices and return it.
- *
- * This function filters the Players at the given indices in the range that
- * starts at begin and returns them as a vector of point types.
- *
- * @param indices Indices of points to return as a separate vector.
- * @param begin Beginning of a Player range.
- */
-static std::vector<point> points_from_indices(const std::vector<int>& indices,
-                                              player_cit begin) {
-    std::vector<point> res(indices.size());
-    std::transform(indices.begin(), indices.end(), res.begin(),
-                   [begin](const int i) {
-                       auto player = std::next(begin, i);
-                       return point(player->x, player->y);
-                   });
-
-    return res;
-}
-
 namespace feature {
 namespace details {
 
-void convex_stats(player_cit begin, player_cit end,
-                  std::vector<double>::iterator speed_begin,
-                  const std::string& prefix, std::vector<double>& features) {
+/**
+ * @brief Calculate the convex hull features of a Player range [begin, end)
+ * from the indices of the players on its convex hull.
+ */
+static void hull_stats(player_cit begin, player_cit end,
+                       std::vector<double>::iterator speed_begin,
+                       const std::vector<int>& indices, Team team,
+                       std::vector<double>& features) {
     // initialize features with default values
     double min_x = feature::default_value();
     double min_y = feature::default_value();
@@ -119,38 +41,36 @@ void convex_stats(player_cit begin, player_cit end,
     double max_dist = feature::default_value();
     double min_dist = feature::default_value();
     double max_speed = feature::default_value();
-    point center(feature::default_value(), feature::default_value());
+    double center_x = feature::default_value();
+    double center_y = feature::default_value();
 
     // if there are at least 3 points (no convex hull of 2 or less points)
     if (std::distance(begin, end) > 2) {
-        // get convex indices and corresponding points
-        std::vector<int> indices = convex_indices(begin, end);
-        std::vector<point> convex_points = points_from_indices(indices, begin);
-
         min_x = std::numeric_limits<double>::max();
         min_y = std::numeric_limits<double>::max();
         max_x = std::numeric_limits<double>::lowest();
         max_y = std::numeric_limits<double>::lowest();
-        center = point(0, 0);
-        double size = static_cast<double>(convex_points.size());
+        center_x = 0;
+        center_y = 0;
+        double size = static_cast<double>(indices.size());
 
         // calculate min/max x/y and center
-        for (const auto& point : convex_points) {
-            min_x = std::min(min_x, point.get<0>());
-            min_y = std::min(min_y, point.get<1>());
-            max_x = std::max(max_x, point.get<0>());
-            max_y = std::max(max_y, point.get<1>());
-
-            center.set<0>(center.get<0>() + point.get<0>() / size);
-            center.set<1>(center.get<1>() + point.get<1>() / size);
+        for (int i : indices) {
+            const Player& point = begin[i];
+            min_x = std::min(min_x, point.x);
+            min_y = std::min(min_y, point.y);
+            max_x = std::max(max_x, point.x);
+            max_y = std::max(max_y, point.y);
+            center_x += point.x / size;
+            center_y += point.y / size;
         }
 
         // farDistance, closestDistance
         max_dist = std::numeric_limits<double>::lowest();
         min_dist = std::numeric_limits<double>::max();
-        for (const auto& point : convex_points) {
-            double distance = dist(point.get<0>(), point.get<1>(),
-                                   center.get<0>(), center.get<1>());
+        for (int i : indices) {
+            const Player& point = begin[i];
+            double distance = dist(point.x, point.y, center_x, center_y);
             max_dist = std::max(max_dist, distance);
             min_dist = std::min(min_dist, distance);
         }
@@ -162,16 +82,49 @@ void convex_stats(player_cit begin, player_cit end,
             max_speed = std::max(max_speed, speed);
         }
     }
+
     // write the results
-    features[name_to_index(prefix + "ConvexMaxX")] = max_x;
-    features[name_to_index(prefix + "ConvexMinX")] = min_x;
-    features[name_to_index(prefix + "ConvexMaxY")] = max_y;
-    features[name_to_index(prefix + "ConvexMinY")] = min_y;
-    features[name_to_index(prefix + "ConvexCenterX")] = center.get<0>();
-    features[name_to_index(prefix + "ConvexCenterY")] = center.get<1>();
-    features[name_to_index(prefix + "ConvexMaxSpeed")] = max_speed;
-    features[name_to_index(prefix + "ConvexFarDistance")] = max_dist;
-    features[name_to_index(prefix + "ConvexClosestDistance")] = min_dist;
+    features[feature_index(team, Stat::ConvexMaxX)] = max_x;
+    features[feature_index(team, Stat::ConvexMinX)] = min_x;
+    features[feature_index(team, Stat::ConvexMaxY)] = max_y;
+    features[feature_index(team, Stat::ConvexMinY)] = min_y;
+    features[feature_index(team, Stat::ConvexCenterX)] = center_x;
+    features[feature_index(team, Stat::ConvexCenterY)] = center_y;
+    features[feature_index(team, Stat::ConvexMaxSpeed)] = max_speed;
+    features[feature_index(team, Stat::ConvexFarDistance)] = max_dist;
+    features[feature_index(team, Stat::ConvexClosestDistance)] = min_dist;
+}
+
+void convex_stats(player_cit begin, player_cit end,
+                  std::vector<double>::iterator speed_begin, Team team,
+                  Workspace& workspace, std::vector<double>& features) {
+    std::vector<int>& hull = workspace.hulls[static_cast<size_t>(team)];
+    if (workspace.track_hulls) {
+        workspace.hull_trackers[static_cast<size_t>(team)].update(
+            begin, end, workspace.hull_order, hull);
+    } else {
+        convex_hull(begin, end, workspace.hull_order, hull);
+    }
+    hull_stats(begin, end, speed_begin, hull, team, features);
+}
+
+void convex_stats(player_cit begin, player_cit middle, player_cit end,
+                  std::vector<double>::iterator speed_begin,
+                  const std::vector<int>& first_hull,
+                  const std::vector<int>& second_hull, Team team,
+                  Workspace& workspace, std::vector<double>& features) {
+    std::vector<int>& hull = workspace.hulls[static_cast<size_t>(team)];
+    merge_hulls(begin, middle, first_hull, second_hull,
+                workspace.hull_vertices, workspace.hull_order, hull);
+    hull_stats(begin, end, speed_begin, hull, team, features);
+}
+
+void convex_stats(player_cit begin, player_cit end,
+                  std::vector<double>::iterator speed_begin,
+                  const std::string& prefix, std::vector<double>& features) {
+    Workspace workspace;
+    convex_stats(begin, end, speed_begin, prefix_to_team(prefix), workspace,
+                 features);
 }
 
 }; // namespace details
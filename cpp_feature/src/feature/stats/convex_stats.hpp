@@ -21,6 +21,8 @@
 
 #include <feature/constants.hpp>
 
+#include "workspace.hpp"
+
 namespace feature {
 namespace details {
 
@@ -35,11 +37,48 @@ namespace details {
  * @param begin Beginning of Player range [begin, end).
  * @param end End of Player range [begin, end).
  * @param speed_begin Beginning of the range holding the speed of each Player.
- * @param prefix Prefix of the feature name. If prefix == "home", then the
- * calculated feature will be written to the index designated to
- * homeInnerDistance. Must be one of "home", "away" or "player".
+ * @param team Team of the players. Features are written to the indices of
+ * this team; e.g. if team == Team::home, homeInnerDistance is written.
+ * @param workspace Buffers to reuse. The convex hull of the players is written
+ * to workspace.hulls[team]. If workspace.track_hulls is set, the hull is found
+ * using workspace.hull_trackers[team].
  * @param features features vector to write the calculated feature in-place.
  */
+void convex_stats(player_cit begin, player_cit end,
+                  std::vector<double>::iterator speed_begin, Team team,
+                  Workspace& workspace, std::vector<double>& features);
+
+/**
+ * @brief Calculate features obtained from the convex hull of the union of two
+ * consecutive Player ranges [begin, middle) and [middle, end) using their
+ * convex hulls.
+ *
+ * The convex hull of the union is found by merging the given hulls as in
+ * merge_hulls; the features are the same as those calculated from the whole
+ * range [begin, end).
+ *
+ * @param begin Beginning of Player range [begin, end).
+ * @param middle Beginning of the second Player range [middle, end).
+ * @param end End of Player range [begin, end).
+ * @param speed_begin Beginning of the range holding the speed of each Player.
+ * @param first_hull Convex hull of [begin, middle) such as
+ * workspace.hulls[Team::home] written by convex_stats.
+ * @param second_hull Convex hull of [middle, end) relative to middle.
+ * @param team Team of the players.
+ * @param workspace Buffers to reuse. The merged hull is written to
+ * workspace.hulls[team], which must not be one of the given hulls.
+ * @param features features vector to write the calculated feature in-place.
+ */
+void convex_stats(player_cit begin, player_cit middle, player_cit end,
+                  std::vector<double>::iterator speed_begin,
+                  const std::vector<int>& first_hull,
+                  const std::vector<int>& second_hull, Team team,
+                  Workspace& workspace, std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the team is given by its name
+ * prefix ("home", "away" or "player") and a new Workspace is used.
+ */
 void convex_stats(player_cit begin, player_cit end,
                   std::vector<double>::iterator speed_begin,
                   const std::string& prefix, std::vector<double>& features);
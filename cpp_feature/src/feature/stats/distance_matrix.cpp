@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "distance_matrix.hpp"
+#include <pairwise_distance.hpp>
+
+namespace feature {
+namespace details {
+
+void DistanceMatrix::reset(player_cit begin, player_cit end) {
+    this->begin = begin;
+    this->n = static_cast<size_t>(std::distance(begin, end));
+    this->xs.resize(this->n);
+    this->ys.resize(this->n);
+    this->segments.resize(this->n);
+    this->segment_begins.clear();
+    for (size_t i = 0; i < this->n; ++i) {
+        this->xs[i] = begin[i].x;
+        this->ys[i] = begin[i].y;
+        // a new segment starts with each player type
+        if (i == 0 || begin[i].type != begin[i - 1].type) {
+            this->segment_begins.push_back(i);
+        }
+        this->segments[i] = this->segment_begins.size() - 1;
+    }
+    this->reset_blocks();
+}
+
+void DistanceMatrix::reset(const Frame& frame) {
+    this->n = frame.size();
+    this->xs.assign(frame.x(), frame.x() + this->n);
+    this->ys.assign(frame.y(), frame.y() + this->n);
+    this->segments.resize(this->n);
+    this->segment_begins.clear();
+    // each non-empty group of the frame is a segment
+    for (size_t group = 0; group <= static_cast<size_t>(PlayerType::count);
+         ++group) {
+        const PlayerSpan span = frame.span(static_cast<PlayerType>(group));
+        if (span.empty()) {
+            continue;
+        }
+        std::fill(this->segments.begin() + span.first,
+                  this->segments.begin() + span.last,
+                  this->segment_begins.size());
+        this->segment_begins.push_back(span.first);
+    }
+    this->reset_blocks();
+}
+
+void DistanceMatrix::reset_blocks() {
+    const size_t num_segments = this->segment_begins.size();
+    this->segment_begins.push_back(this->n);
+
+    this->computed.assign(num_segments * num_segments, 0);
+    this->num_computed = 0;
+    this->distances.resize(this->n * this->n);
+}
+
+double DistanceMatrix::operator()(size_t i, size_t j) {
+    const size_t a = std::min(this->segments[i], this->segments[j]);
+    const size_t b = std::max(this->segments[i], this->segments[j]);
+    this->compute_block(a, b);
+    return this->distances[i * this->n + j];
+}
+
+double DistanceMatrix::pair_sum(size_t first, size_t last) {
+    if (last <= first + 1) {
+        return 0;
+    }
+
+    // all the blocks of the segments the range touches
+    const size_t first_segment = this->segments[first];
+    const size_t last_segment = this->segments[last - 1];
+    for (size_t a = first_segment; a <= last_segment; ++a) {
+        for (size_t b = a; b <= last_segment; ++b) {
+            this->compute_block(a, b);
+        }
+    }
+
+    // same summation order as pairwise_distance_sum
+    double lanes[pairwise_lanes] = {0};
+    for (size_t i = first + 1; i < last; ++i) {
+        const double* row = &this->distances[i * this->n];
+        for (size_t j = first; j < i; ++j) {
+            lanes[(j - first) % pairwise_lanes] += row[j];
+        }
+    }
+    return reduce_pairwise_lanes(lanes);
+}
+
+void DistanceMatrix::compute_block(size_t a, size_t b) {
+    const size_t num_segments = this->segment_begins.size() - 1;
+    if (this->computed[a * num_segments + b]) {
+        return;
+    }
+    this->computed[a * num_segments + b] = 1;
+    this->computed[b * num_segments + a] = 1;
+    ++this->num_computed;
+
+    const size_t n = this->n;
+    const size_t b_begin = this->segment_begins[b];
+    for (size_t i = this->segment_begins[a]; i < this->segment_begins[a + 1];
+         ++i) {
+        // a diagonal block needs only the pairs below the diagonal
+        const size_t b_end = a == b ? i : this->segment_begins[b + 1];
+        double* row = &this->distances[i * n];
+        point_distances(this->xs[i], this->ys[i], &this->xs[b_begin],
+                        &this->ys[b_begin], b_end - b_begin, row + b_begin);
+        for (size_t j = b_begin; j < b_end; ++j) {
+            this->distances[j * n + i] = row[j];
+        }
+        if (a == b) {
+            row[i] = 0;
+        }
+    }
+}
+
+}; // namespace details
+}; // namespace feature
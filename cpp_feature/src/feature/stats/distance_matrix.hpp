@@ -0,0 +1,150 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <feature/constants.hpp>
+#include <feature/frame.hpp>
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief DistanceMatrix holds the Euclidean distances between all pairs of
+ * players of a frame.
+ *
+ * Players of a frame are sorted with respect to their types; hence, the
+ * matrix is made of blocks where each block holds the distances between the
+ * players of two types, such as the home-home, away-away and home-away
+ * blocks. The matrix is reset once per frame and a block is computed only
+ * when one of its distances is requested for the first time. Afterwards, all
+ * the statistics of the same frame reuse it.
+ *
+ * Indices are relative to the beginning of the Player range given to reset.
+ * Once the buffers have grown to the number of players, no memory is
+ * allocated.
+ */
+class DistanceMatrix {
+  public:
+    /**
+     * @brief Start a new frame whose players are given in [begin, end)
+     * sorted with respect to their types. No distances are computed.
+     *
+     * @param begin Beginning of the Player range [begin, end).
+     * @param end End of the Player range [begin, end).
+     */
+    void reset(player_cit begin, player_cit end);
+
+    /**
+     * @brief Start a new frame whose players are given in the given Frame.
+     * No distances are computed and index(player_cit) must not be used.
+     */
+    void reset(const Frame& frame);
+
+    /**
+     * @brief Return the number of players of the current frame.
+     */
+    size_t size() const { return this->n; }
+
+    /**
+     * @brief Return the index of the given player of the current frame.
+     */
+    size_t index(player_cit it) const {
+        return static_cast<size_t>(std::distance(this->begin, it));
+    }
+
+    /**
+     * @brief Return the distance between players i and j of the current
+     * frame, computing its block if necessary.
+     */
+    double operator()(size_t i, size_t j);
+
+    /**
+     * @brief Return the sum of the distances between all pairs of the players
+     * in [first, last), computing the blocks if necessary.
+     *
+     * The sum is bitwise equal to pairwise_distance_sum of the same players.
+     *
+     * @param first Index of the first player of the range.
+     * @param last Index one past the last player of the range.
+     *
+     * @return Sum of the distances of all pairs; 0 if there are less than two
+     * players.
+     */
+    double pair_sum(size_t first, size_t last);
+
+    /**
+     * @brief Return the number of blocks computed in the current frame.
+     */
+    size_t computed_blocks() const { return this->num_computed; }
+
+  private:
+    /**
+     * @brief Mark all the blocks of the segments as not computed.
+     */
+    void reset_blocks();
+
+    /**
+     * @brief Compute the block of the players of segments a and b, a <= b.
+     */
+    void compute_block(size_t a, size_t b);
+
+  private:
+    /**
+     * @brief Beginning of the players of the current frame.
+     */
+    player_cit begin;
+    /**
+     * @brief Number of players of the current frame.
+     */
+    size_t n = 0;
+    /**
+     * @brief Player x coordinates.
+     */
+    std::vector<double> xs;
+    /**
+     * @brief Player y coordinates.
+     */
+    std::vector<double> ys;
+    /**
+     * @brief Index of the first player of each segment of players of the same
+     * type, followed by n.
+     */
+    std::vector<size_t> segment_begins;
+    /**
+     * @brief Segment of each player.
+     */
+    std::vector<size_t> segments;
+    /**
+     * @brief 1 for each computed block in row major order of the segments.
+     */
+    std::vector<char> computed;
+    /**
+     * @brief Number of computed blocks.
+     */
+    size_t num_computed = 0;
+    /**
+     * @brief n x n distances in row major order.
+     */
+    std::vector<double> distances;
+};
+
+}; // namespace details
+}; // namespace feature
@@ -14,32 +14,64 @@
  * limitations under the License.
  */
 
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "distance_stats.hpp"
-#include <utils.hpp>
+#include <pairwise_distance.hpp>
 
 namespace feature {
 namespace details {
 
-void distance_stats(player_cit begin, player_cit end, const std::string& prefix,
-                    std::vector<double>& features) {
+void distance_stats(player_cit begin, player_cit end, Team team,
+                    Workspace& workspace, std::vector<double>& features) {
     double inner_dist = 0;
 
     // if no players, write the default value
     if (begin == end) {
         inner_dist = feature::default_value();
+    } else {
+        // copy the coordinates to padded arrays for the vectorized kernel
+        const size_t n = static_cast<size_t>(std::distance(begin, end));
+        std::vector<double>& xs = workspace.xs;
+        std::vector<double>& ys = workspace.ys;
+        xs.assign(pairwise_padded_size(n), 0);
+        ys.assign(pairwise_padded_size(n), 0);
+        for (size_t i = 0; i < n; ++i) {
+            xs[i] = begin[i].x;
+            ys[i] = begin[i].y;
+        }
+
+        // sum of distances of all possible pairs
+        inner_dist = pairwise_distance_sum(xs.data(), ys.data(), n);
     }
 
-    // sum of distances of all possible pairs
-    for (auto left = begin; left != end; ++left) {
-        for (auto right = std::next(left); right != end; ++right) {
-            inner_dist += dist(left->x, left->y, right->x, right->y);
-        }
+    features[feature_index(team, Stat::InnerDistance)] = inner_dist;
+}
+
+void distance_stats(const Frame& frame, PlayerSpan span, Team team,
+                    Workspace& workspace, std::vector<double>& features) {
+    double inner_dist = feature::default_value();
+
+    // sum of distances of all possible pairs if there are any players
+    if (!span.empty()) {
+        inner_dist = pairwise_distance_sum(frame.x() + span.first,
+                                           frame.y() + span.first, span.size());
     }
 
-    features[name_to_index(prefix + "InnerDistance")] = inner_dist;
+    features[feature_index(team, Stat::InnerDistance)] = inner_dist;
+}
+
+void distance_stats(player_cit begin, player_cit end, Team team,
+                    std::vector<double>& features) {
+    Workspace workspace;
+    distance_stats(begin, end, team, workspace, features);
+}
+
+void distance_stats(player_cit begin, player_cit end, const std::string& prefix,
+                    std::vector<double>& features) {
+    distance_stats(begin, end, prefix_to_team(prefix), features);
 }
 
 }; // namespace details
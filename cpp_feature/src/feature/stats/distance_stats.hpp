@@ -20,6 +20,9 @@
 #include <vector>
 
 #include <feature/constants.hpp>
+#include <feature/frame.hpp>
+
+#include "workspace.hpp"
 
 namespace feature {
 namespace details {
@@ -29,15 +32,36 @@ namespace details {
  * players.
  *
  * This function computes innerDistance of the range of players given in
- * [begin, end).
+ * [begin, end). Distances of all pairs are summed using pairwise_distance_sum.
  *
  * @param begin Beginning of the Player range [begin, end).
  * @param end End of the Player range [begin, end).
- * @param prefix Prefix of the feature name. If prefix == "home", then the
- * calculated feature will be written to the index designated to
- * homeInnerDistance. Must be one of "home", "away" or "player".
+ * @param team Team of the players. Features are written to the indices of
+ * this team; e.g. if team == Team::home, homeInnerDistance is written.
+ * @param workspace Workspace whose buffers are used for the coordinates.
  * @param features features vector to write the calculated feature in-place.
  */
+void distance_stats(player_cit begin, player_cit end, Team team,
+                    Workspace& workspace, std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the players are given by a
+ * PlayerSpan of a Frame. The coordinates of the Frame are given to
+ * pairwise_distance_sum without copying.
+ */
+void distance_stats(const Frame& frame, PlayerSpan span, Team team,
+                    Workspace& workspace, std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where a new Workspace is used.
+ */
+void distance_stats(player_cit begin, player_cit end, Team team,
+                    std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the team is given by its name
+ * prefix ("home", "away" or "player").
+ */
 void distance_stats(player_cit begin, player_cit end, const std::string& prefix,
                     std::vector<double>& features);
 
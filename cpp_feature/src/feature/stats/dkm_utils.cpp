@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <cmath>
+#include <numeric>
+
 #include "dkm_utils.hpp"
 
 namespace feature {
@@ -30,5 +33,346 @@ dkm_point_seq<2> players_to_points(player_cit begin, player_cit end) {
     return points;
 }
 
+void players_to_points(player_cit begin, player_cit end,
+                       dkm_point_seq<2>& points) {
+    points.resize(std::distance(begin, end));
+
+    // point is created using x and y coordinates of a Player
+    std::transform(begin, end, points.begin(),
+                   [](const auto& player) -> dkm_point<2> {
+                       return {player.x, player.y};
+                   });
+}
+
+uint64_t mix_seed(uint64_t seed, uint64_t value) {
+    uint64_t z = seed + 0x9e3779b97f4a7c15 * (value + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+void TwoMeans::fit(const dkm_point_seq<2>& points) {
+    const size_t n = points.size();
+    this->labels.assign(n, 0);
+    this->sse = 0;
+    if (n < 2) {
+        this->means.assign(2, n == 0 ? dkm_point<2>{} : points[0]);
+        return;
+    }
+
+    // center the points to reduce cancellation in the sums of squares
+    double mean_x = 0;
+    double mean_y = 0;
+    for (const auto& point : points) {
+        mean_x += point[0];
+        mean_y += point[1];
+    }
+    mean_x /= n;
+    mean_y /= n;
+    this->centered.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        this->centered[i] = {points[i][0] - mean_x, points[i][1] - mean_y};
+    }
+
+    // directions perpendicular to the line through each pair of points.
+    // Direction (1, 0) is skipped since the initial order is the order right
+    // after it.
+    this->unsorted_events.clear();
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t j = i + 1; j < n; ++j) {
+            double dir_x = this->centered[i][1] - this->centered[j][1];
+            double dir_y = this->centered[j][0] - this->centered[i][0];
+            if (dir_y < 0) {
+                dir_x = -dir_x;
+                dir_y = -dir_y;
+            }
+            if (dir_y == 0) {
+                continue;
+            }
+            const double key = -dir_x / (std::abs(dir_x) + dir_y);
+            this->unsorted_events.push_back({key, i, j});
+        }
+    }
+    this->sort_events();
+
+    // order right after direction (1, 0) sorts the points by x and then y
+    this->order.resize(n);
+    this->position.resize(n);
+    this->projections.resize(n);
+    this->prefix.resize(n + 1);
+    this->inverse.resize(n + 1);
+    for (size_t k = 1; k <= n; ++k) {
+        this->inverse[k] = 1.0 / k;
+    }
+    std::iota(this->order.begin(), this->order.end(), 0);
+    std::sort(this->order.begin(), this->order.end(),
+              [this](uint32_t i, uint32_t j) {
+                  return this->centered[i] < this->centered[j];
+              });
+    for (size_t p = 0; p < n; ++p) {
+        this->position[this->order[p]] = p;
+    }
+    this->prefix[0] = {0, 0, 0};
+    this->prefix[n] = {0, 0, 0};
+    for (const auto& point : this->centered) {
+        this->prefix[n][0] += point[0];
+        this->prefix[n][1] += point[1];
+        this->prefix[n][2] += point[0] * point[0] + point[1] * point[1];
+    }
+    this->best_sse = std::numeric_limits<double>::max();
+    this->evaluate(0, n - 1);
+
+    // resort the range of the points of the events at the same direction
+    size_t group_begin = 0;
+    while (group_begin < this->events.size()) {
+        const double key = this->events[group_begin].key;
+        size_t lo = n;
+        size_t hi = 0;
+        size_t group_end = group_begin;
+        for (; group_end < this->events.size() &&
+               this->events[group_end].key == key;
+             ++group_end) {
+            const Event& event = this->events[group_end];
+            const size_t first = this->position[event.first];
+            const size_t second = this->position[event.second];
+            lo = std::min(lo, std::min(first, second));
+            hi = std::max(hi, std::max(first, second));
+        }
+        if (group_end == group_begin + 1 && hi == lo + 1) {
+            // two adjacent points swap
+            std::swap(this->order[lo], this->order[hi]);
+            this->position[this->order[lo]] = lo;
+            this->position[this->order[hi]] = hi;
+            this->evaluate(lo, hi);
+        } else {
+            const double next_key = (group_end < this->events.size())
+                                        ? this->events[group_end].key
+                                        : 1.0;
+            this->resort(lo, hi, (key + next_key) / 2);
+        }
+        group_begin = group_end;
+    }
+
+    // label of the cluster of the first point is 0
+    if (this->labels[0] != 0) {
+        for (auto& label : this->labels) {
+            label = 1 - label;
+        }
+    }
+
+    // cluster centers and sum of squared distances
+    std::array<double, 2> counts = {0, 0};
+    this->means.assign(2, dkm_point<2>{});
+    for (size_t i = 0; i < n; ++i) {
+        auto& mean = this->means[this->labels[i]];
+        mean[0] += points[i][0];
+        mean[1] += points[i][1];
+        counts[this->labels[i]] += 1;
+    }
+    for (size_t m = 0; m < 2; ++m) {
+        this->means[m][0] /= counts[m];
+        this->means[m][1] /= counts[m];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const auto& mean = this->means[this->labels[i]];
+        const double dx = points[i][0] - mean[0];
+        const double dy = points[i][1] - mean[1];
+        this->sse += dx * dx + dy * dy;
+    }
+}
+
+void TwoMeans::sort_events() {
+    const size_t num_events = this->unsorted_events.size();
+    const size_t num_buckets = buckets_per_event * num_events + 1;
+    auto bucket = [num_buckets](double key) {
+        // keys are in (-1, 1)
+        const size_t b = static_cast<size_t>((key + 1) / 2 * num_buckets);
+        return std::min(b, num_buckets - 1);
+    };
+
+    // counting sort with respect to buckets
+    this->bucket_counts.assign(num_buckets + 1, 0);
+    for (const Event& event : this->unsorted_events) {
+        ++this->bucket_counts[bucket(event.key) + 1];
+    }
+    for (size_t b = 0; b < num_buckets; ++b) {
+        this->bucket_counts[b + 1] += this->bucket_counts[b];
+    }
+    this->events.resize(num_events);
+    for (const Event& event : this->unsorted_events) {
+        this->events[this->bucket_counts[bucket(event.key)]++] = event;
+    }
+
+    // insertion sort within buckets
+    for (size_t i = 1; i < num_events; ++i) {
+        const Event event = this->events[i];
+        size_t j = i;
+        while (j > 0 && this->events[j - 1].key > event.key) {
+            this->events[j] = this->events[j - 1];
+            --j;
+        }
+        this->events[j] = event;
+    }
+}
+
+void TwoMeans::resort(size_t lo, size_t hi, double key) {
+    // direction with the given pseudo-angle
+    const double dir_x = -key;
+    const double dir_y = 1 - std::abs(key);
+    for (size_t p = lo; p <= hi; ++p) {
+        const auto& point = this->centered[this->order[p]];
+        this->projections[this->order[p]] = point[0] * dir_x + point[1] * dir_y;
+    }
+
+    // insertion sort keeps the order of the same points
+    for (size_t i = lo + 1; i <= hi; ++i) {
+        const uint32_t index = this->order[i];
+        const double projection = this->projections[index];
+        size_t j = i;
+        while (j > lo && this->projections[this->order[j - 1]] > projection) {
+            this->order[j] = this->order[j - 1];
+            --j;
+        }
+        this->order[j] = index;
+    }
+    for (size_t p = lo; p <= hi; ++p) {
+        this->position[this->order[p]] = p;
+    }
+
+    this->evaluate(lo, hi);
+}
+
+void TwoMeans::evaluate(size_t lo, size_t hi) {
+    // the sum of the points [lo, hi] doesn't change
+    for (size_t p = lo; p < hi; ++p) {
+        const auto& point = this->centered[this->order[p]];
+        const auto& sums = this->prefix[p];
+        this->prefix[p + 1] = {sums[0] + point[0], sums[1] + point[1],
+                               sums[2] + point[0] * point[0] +
+                                   point[1] * point[1]};
+    }
+
+    // the first k points in order make the first cluster
+    const size_t n = this->order.size();
+    const auto& total = this->prefix[n];
+    for (size_t k = lo + 1; k <= hi; ++k) {
+        const auto& left = this->prefix[k];
+        const double right_x = total[0] - left[0];
+        const double right_y = total[1] - left[1];
+        const double value =
+            left[2] - (left[0] * left[0] + left[1] * left[1]) * this->inverse[k] +
+            (total[2] - left[2]) -
+            (right_x * right_x + right_y * right_y) * this->inverse[n - k];
+        if (value < this->best_sse) {
+            this->best_sse = value;
+            for (size_t p = 0; p < n; ++p) {
+                this->labels[this->order[p]] = (p < k) ? 0 : 1;
+            }
+        }
+    }
+}
+
+dkm_means<2> two_means(const dkm_point_seq<2>& points) {
+    TwoMeans clustering;
+    clustering.fit(points);
+    return dkm_means<2>(clustering.centroids(), clustering.point_labels());
+}
+
+void KMeans1D::fit(const dkm_point_seq<1>& points, uint32_t n_clusters) {
+    const size_t n = points.size();
+    this->labels.assign(n, 0);
+    this->means.assign(n_clusters, dkm_point<1>{});
+    this->sse = 0;
+    if (n == 0 || n_clusters == 0) {
+        return;
+    }
+    // there can't be more non-empty clusters than points
+    const size_t k = std::min<size_t>(n_clusters, n);
+
+    // sort the points
+    this->order.resize(n);
+    std::iota(this->order.begin(), this->order.end(), 0);
+    std::sort(this->order.begin(), this->order.end(),
+              [&points](uint32_t i, uint32_t j) {
+                  return points[i][0] < points[j][0];
+              });
+
+    // prefix sums of the values centered at their mean to reduce cancellation
+    double mean = 0;
+    for (const auto& point : points) {
+        mean += point[0];
+    }
+    mean /= n;
+    this->sums.resize(n + 1);
+    this->squares.resize(n + 1);
+    this->inverse.resize(n + 1);
+    for (size_t p = 1; p <= n; ++p) {
+        this->inverse[p] = 1.0 / p;
+    }
+    this->sums[0] = 0;
+    this->squares[0] = 0;
+    for (size_t p = 0; p < n; ++p) {
+        const double value = points[this->order[p]][0] - mean;
+        this->sums[p + 1] = this->sums[p] + value;
+        this->squares[p + 1] = this->squares[p] + value * value;
+    }
+
+    // lowest cost of the first i points in m + 1 clusters; each cluster has at
+    // least one point
+    const size_t width = n + 1;
+    this->costs.assign(k * width, std::numeric_limits<double>::max());
+    this->splits.assign(k * width, 0);
+    for (size_t i = 1; i <= n; ++i) {
+        this->costs[i] = this->range_cost(0, i);
+    }
+    for (size_t m = 1; m < k; ++m) {
+        for (size_t i = m + 1; i <= n; ++i) {
+            double best = std::numeric_limits<double>::max();
+            uint32_t best_split = m;
+            for (size_t j = m; j < i; ++j) {
+                const double cost =
+                    this->costs[(m - 1) * width + j] + this->range_cost(j, i);
+                if (cost < best) {
+                    best = cost;
+                    best_split = j;
+                }
+            }
+            this->costs[m * width + i] = best;
+            this->splits[m * width + i] = best_split;
+        }
+    }
+
+    // label the clusters from the last one to the first one
+    size_t end = n;
+    for (size_t m = k; m-- > 0;) {
+        const size_t begin = (m == 0) ? 0 : this->splits[m * width + end];
+        double center = 0;
+        for (size_t p = begin; p < end; ++p) {
+            this->labels[this->order[p]] = m;
+            center += points[this->order[p]][0];
+        }
+        center /= (end - begin);
+        this->means[m][0] = center;
+        for (size_t p = begin; p < end; ++p) {
+            const double delta = points[this->order[p]][0] - center;
+            this->sse += delta * delta;
+        }
+        end = begin;
+    }
+}
+
+double KMeans1D::range_cost(size_t j, size_t i) const {
+    const double sum = this->sums[i] - this->sums[j];
+    const double cost =
+        this->squares[i] - this->squares[j] - sum * sum * this->inverse[i - j];
+    return std::max(cost, 0.0);
+}
+
+dkm_means<1> kmeans_1d(const dkm_point_seq<1>& points, uint32_t n_clusters) {
+    KMeans1D clustering;
+    clustering.fit(points, n_clusters);
+    return dkm_means<1>(clustering.centroids(), clustering.point_labels());
+}
+
 }; // namespace details
 }; // namespace feature
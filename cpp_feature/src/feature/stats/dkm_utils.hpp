@@ -18,6 +18,9 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
 #include <tuple>
 #include <vector>
 
@@ -26,6 +29,8 @@
 #include <feature/constants.hpp>
 #include <utils.hpp>
 
+#include "small_kmeans.hpp"
+
 namespace feature {
 namespace details {
 
@@ -75,6 +80,21 @@ using dkm_means = std::tuple<dkm_point_seq<N>, dkm_label_seq>;
  */
 dkm_point_seq<2> players_to_points(player_cit begin, player_cit end);
 
+/**
+ * @brief Write the x and y coordinates of Players in the given range to the
+ * given point sequence.
+ *
+ * The capacity of points is reused; no memory is allocated if it is large
+ * enough.
+ *
+ * @param begin Beginning of the Player range [begin, end).
+ * @param end End of the Player range [begin, end).
+ * @param points Output point sequence that is resized to the number of
+ * Players.
+ */
+void players_to_points(player_cit begin, player_cit end,
+                       dkm_point_seq<2>& points);
+
 /**
  * @brief Calculate the Euclidean distance from each point in the given
  * dkm_point_seq to the given center point and write the results to given output
@@ -222,29 +242,671 @@ dkm_means<N> get_best_means(const dkm_point_seq<N>& points,
     return dkm_means<N>(*best_means); // copy and return
 }
 
+/**
+ * @brief Random number engine used to initialize k-means clusterings.
+ */
+using kmeans_engine = std::mt19937_64;
+
+/**
+ * @brief Derive the seed of an independent random stream from the given seed
+ * and value.
+ *
+ * The value is mixed into the seed using the SplitMix64 finalizer so that
+ * close values such as consecutive timestamps give unrelated streams.
+ *
+ * @param seed Seed of the parent stream.
+ * @param value Value identifying the derived stream.
+ *
+ * @return Seed of the derived stream.
+ */
+uint64_t mix_seed(uint64_t seed, uint64_t value);
+
+/**
+ * @brief RestartPolicy determines how many times k-means is run from random
+ * initializations to find the clustering with the lowest inertia.
+ */
+struct RestartPolicy {
+    /**
+     * @brief Maximum number of times k-means algorithm will be run.
+     */
+    int n_init = 10;
+    /**
+     * @brief Number of consecutive runs that don't lower the inertia after
+     * which no more runs are made. If 0, all n_init runs are made.
+     */
+    int patience = 0;
+};
+
+/**
+ * @brief KMeans computes k-means clusterings of N dimensional points using
+ * buffers that are reused between calls.
+ *
+ * Each clustering is computed the same way as dkm::kmeans_lloyd: means are
+ * initialized using k-means++ and then updated using Lloyd's algorithm until
+ * they don't change. Among multiple runs, the clustering with the lowest
+ * inertia as defined in means_inertia is kept; runs stop early once a
+ * RestartPolicy's patience is exhausted. Once the buffers have grown to
+ * the number of points, no memory is allocated. Lloyd's algorithm runs in
+ * small_lloyd for 2 or 4 clusters of at most small_kmeans_capacity points.
+ *
+ * The best clustering is kept between calls; fit_warm starts Lloyd's algorithm
+ * from it to cluster points that changed only slightly, such as the players in
+ * consecutive frames.
+ *
+ * @tparam N Dimension of the points.
+ */
+template <size_t N> class KMeans {
+  public:
+    /**
+     * @brief Calculate k-means clustering of the given points n_init times and
+     * keep the clustering with the lowest inertia.
+     *
+     * @param points Points to cluster. There must be at least n_clusters
+     * points.
+     * @param n_clusters Number of clusters to compute in k-means (k).
+     * @param n_init Number of times k-means algorithm will be run.
+     * @param engine Random number engine to initialize the means.
+     */
+    void fit(const dkm_point_seq<N>& points, uint32_t n_clusters, int n_init,
+             kmeans_engine& engine) {
+        this->fit(points, n_clusters, RestartPolicy{n_init, 0}, engine);
+    }
+
+    /**
+     * @brief Same as the function above where k-means algorithm is run as
+     * determined by the given RestartPolicy.
+     */
+    void fit(const dkm_point_seq<N>& points, uint32_t n_clusters,
+             const RestartPolicy& policy, kmeans_engine& engine) {
+        this->restarts(points, n_clusters, policy, engine, false);
+    }
+
+    /**
+     * @brief Calculate k-means clustering of the given points starting from the
+     * means of the previous best clustering, and fall back to n_init runs of
+     * fit if the inertia gets worse by more than the given tolerance.
+     *
+     * If there is no previous clustering with n_clusters clusters, this
+     * function is the same as fit. Otherwise, Lloyd's algorithm is run once
+     * starting from the previous means. The result is kept if its inertia is
+     * at most (1 + tolerance) times the previous inertia. If not, it is
+     * compared with the results of n_init runs of k-means++ initializations
+     * and the clustering with the lowest inertia is kept.
+     *
+     * @param points Points to cluster. There must be at least n_clusters
+     * points.
+     * @param n_clusters Number of clusters to compute in k-means (k).
+     * @param n_init Number of times k-means algorithm will be run on fallback.
+     * @param tolerance Allowed relative increase of the inertia.
+     * @param engine Random number engine to initialize the means on fallback.
+     *
+     * @return true if the warm started clustering is kept; false if k-means
+     * algorithm is run n_init times.
+     */
+    bool fit_warm(const dkm_point_seq<N>& points, uint32_t n_clusters,
+                  int n_init, double tolerance, kmeans_engine& engine) {
+        return this->fit_warm(points, n_clusters, RestartPolicy{n_init, 0},
+                              tolerance, engine);
+    }
+
+    /**
+     * @brief Same as the function above where k-means algorithm is run as
+     * determined by the given RestartPolicy on fallback.
+     */
+    bool fit_warm(const dkm_point_seq<N>& points, uint32_t n_clusters,
+                  const RestartPolicy& policy, double tolerance,
+                  kmeans_engine& engine) {
+        this->num_runs = 0;
+        if (this->best_means.size() != n_clusters) {
+            this->fit(points, n_clusters, policy, engine);
+            return false;
+        }
+
+        // Lloyd's algorithm from the previous means
+        const double previous_inertia = this->best_inertia;
+        this->means.assign(this->best_means.begin(), this->best_means.end());
+        this->lloyd(points, n_clusters);
+        this->best_inertia = this->current_inertia(points, n_clusters);
+        this->best_means.swap(this->means);
+        this->best_labels.swap(this->labels);
+        if (this->best_inertia <= (1 + tolerance) * previous_inertia) {
+            return true;
+        }
+
+        // the clustering got worse; try k-means++ initializations as well
+        this->restarts(points, n_clusters, policy, engine, true);
+        return false;
+    }
+
+    /**
+     * @brief Return the cluster centers of the best clustering.
+     */
+    const dkm_point_seq<N>& centroids() const { return this->best_means; }
+
+    /**
+     * @brief Return the cluster label of each point in the best clustering.
+     */
+    const dkm_label_seq& point_labels() const { return this->best_labels; }
+
+    /**
+     * @brief Return the inertia of the best clustering.
+     */
+    double inertia() const { return this->best_inertia; }
+
+    /**
+     * @brief Return the number of times k-means algorithm was run from random
+     * initializations in the last call to fit or fit_warm.
+     */
+    int runs() const { return this->num_runs; }
+
+  private:
+    /**
+     * @brief Squared Euclidean distance between two points.
+     */
+    static double distance_squared(const dkm_point<N>& a,
+                                   const dkm_point<N>& b) {
+        double d_squared = 0;
+        for (size_t i = 0; i < N; ++i) {
+            const double delta = a[i] - b[i];
+            d_squared += delta * delta;
+        }
+        return d_squared;
+    }
+
+    /**
+     * @brief Initialize the means using k-means++.
+     */
+    void init_plusplus(const dkm_point_seq<N>& points, uint32_t n_clusters,
+                       kmeans_engine& engine) {
+        this->means.resize(n_clusters);
+        this->weights.resize(points.size());
+
+        // select first mean at random from the set
+        std::uniform_int_distribution<size_t> uniform(0, points.size() - 1);
+        this->means[0] = points[uniform(engine)];
+
+        for (uint32_t count = 1; count < n_clusters; ++count) {
+            // squared distance of each point to its closest mean
+            double total = 0;
+            for (size_t i = 0; i < points.size(); ++i) {
+                double closest = distance_squared(points[i], this->means[0]);
+                for (uint32_t m = 1; m < count; ++m) {
+                    closest = std::min(closest,
+                                       distance_squared(points[i], this->means[m]));
+                }
+                this->weights[i] = closest;
+                total += closest;
+            }
+
+            // pick a random point weighted by the distance from existing means
+            size_t chosen = 0;
+            if (total > 0) {
+                std::uniform_real_distribution<double> real(0, total);
+                const double target = real(engine);
+                double cumulative = 0;
+                for (size_t i = 0; i < points.size(); ++i) {
+                    if (this->weights[i] > 0) {
+                        chosen = i;
+                        cumulative += this->weights[i];
+                        if (target < cumulative) {
+                            break;
+                        }
+                    }
+                }
+            } else {
+                chosen = uniform(engine);
+            }
+            this->means[count] = points[chosen];
+        }
+    }
+
+    /**
+     * @brief Run k-means as determined by the given policy and keep the
+     * clustering with the lowest inertia.
+     *
+     * @param keep_best If true, the current best clustering is kept unless a
+     * run has a lower inertia.
+     */
+    void restarts(const dkm_point_seq<N>& points, uint32_t n_clusters,
+                  const RestartPolicy& policy, kmeans_engine& engine,
+                  bool keep_best) {
+        this->num_runs = 0;
+        int without_improvement = 0;
+        for (int i = 0; i < policy.n_init; ++i) {
+            this->run(points, n_clusters, engine);
+            ++this->num_runs;
+            const double inertia = this->current_inertia(points, n_clusters);
+            if ((i == 0 && !keep_best) || inertia < this->best_inertia) {
+                this->best_inertia = inertia;
+                this->best_means.swap(this->means);
+                this->best_labels.swap(this->labels);
+                without_improvement = 0;
+            } else if (++without_improvement == policy.patience) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Run k-means once and store the result in means and labels.
+     */
+    void run(const dkm_point_seq<N>& points, uint32_t n_clusters,
+             kmeans_engine& engine) {
+        this->init_plusplus(points, n_clusters, engine);
+        this->lloyd(points, n_clusters);
+    }
+
+    /**
+     * @brief Update the initial means using Lloyd's algorithm until they don't
+     * change and store the result in means and labels.
+     */
+    void lloyd(const dkm_point_seq<N>& points, uint32_t n_clusters) {
+        this->labels.resize(points.size());
+#ifdef __SSE2__
+        // fixed-size SIMD kernels for the common number of clusters
+        if (points.size() <= small_kmeans_capacity) {
+            if (n_clusters == 2) {
+                small_lloyd<N, 2>(points, this->means, this->labels);
+                return;
+            }
+            if (n_clusters == 4) {
+                small_lloyd<N, 4>(points, this->means, this->labels);
+                return;
+            }
+        }
+#endif
+        this->counts.resize(n_clusters);
+
+        // calculate new means until convergence is reached
+        bool changed = true;
+        while (changed) {
+            // index of the closest mean of each point
+            for (size_t i = 0; i < points.size(); ++i) {
+                double smallest = distance_squared(points[i], this->means[0]);
+                uint32_t index = 0;
+                for (uint32_t m = 1; m < n_clusters; ++m) {
+                    const double d = distance_squared(points[i], this->means[m]);
+                    if (d < smallest) {
+                        smallest = d;
+                        index = m;
+                    }
+                }
+                this->labels[i] = index;
+            }
+
+            // means of the clusters; empty clusters keep their old means
+            this->old_means.swap(this->means);
+            this->means.assign(n_clusters, dkm_point<N>{});
+            std::fill(this->counts.begin(), this->counts.end(), 0);
+            for (size_t i = 0; i < points.size(); ++i) {
+                auto& mean = this->means[this->labels[i]];
+                this->counts[this->labels[i]] += 1;
+                for (size_t j = 0; j < N; ++j) {
+                    mean[j] += points[i][j];
+                }
+            }
+            for (uint32_t m = 0; m < n_clusters; ++m) {
+                if (this->counts[m] == 0) {
+                    this->means[m] = this->old_means[m];
+                } else {
+                    for (size_t j = 0; j < N; ++j) {
+                        this->means[m][j] /= this->counts[m];
+                    }
+                }
+            }
+            changed = this->means != this->old_means;
+        }
+    }
+
+    /**
+     * @brief Calculate the inertia of the clustering in means and labels as
+     * defined in means_inertia.
+     */
+    double current_inertia(const dkm_point_seq<N>& points,
+                           uint32_t n_clusters) {
+        // sum of the distances of the points of each cluster to its center
+        this->cluster_sums.assign(n_clusters, 0);
+        for (size_t i = 0; i < points.size(); ++i) {
+            const uint32_t label = this->labels[i];
+            this->cluster_sums[label] +=
+                dist<N>(points[i], this->means[label]);
+        }
+        double inertia = 0;
+        for (const double sum : this->cluster_sums) {
+            inertia += sum;
+        }
+        return inertia;
+    }
+
+  private:
+    /**
+     * @brief Means of the current run.
+     */
+    dkm_point_seq<N> means;
+    /**
+     * @brief Means of the previous iteration of the current run.
+     */
+    dkm_point_seq<N> old_means;
+    /**
+     * @brief Labels of the current run.
+     */
+    dkm_label_seq labels;
+    /**
+     * @brief Means of the best run.
+     */
+    dkm_point_seq<N> best_means;
+    /**
+     * @brief Labels of the best run.
+     */
+    dkm_label_seq best_labels;
+    /**
+     * @brief Inertia of the best run.
+     */
+    double best_inertia = std::numeric_limits<double>::max();
+    /**
+     * @brief Number of runs in the last call to fit or fit_warm.
+     */
+    int num_runs = 0;
+    /**
+     * @brief k-means++ weight of each point.
+     */
+    std::vector<double> weights;
+    /**
+     * @brief Number of points in each cluster.
+     */
+    std::vector<double> counts;
+    /**
+     * @brief Sum of distances to the center of each cluster.
+     */
+    std::vector<double> cluster_sums;
+};
+
+/**
+ * @brief TwoMeans computes the optimal 2-means clustering of 2D points using
+ * buffers that are reused between calls.
+ *
+ * The clusters of an optimal 2-means clustering are separated by a line.
+ * Hence, if the points are projected onto the normal of this line, the
+ * clusters are a prefix and a suffix of the points sorted by their
+ * projections. TwoMeans rotates the direction of projection by 180 degrees
+ * and keeps the sorted order up to date: the order of two points changes
+ * only when the direction becomes perpendicular to the line through them.
+ * Every split of the order is evaluated using prefix sums in \f$O(1)\f$ time
+ * when it changes; hence, the clustering with the lowest sum of squared
+ * distances is found in \f$O(N^2logN)\f$ time without depending on any
+ * random state. Once the buffers have grown to the number of points, no
+ * memory is allocated.
+ */
+class TwoMeans {
+  public:
+    /**
+     * @brief Calculate the optimal 2-means clustering of the given points.
+     *
+     * @param points Points to cluster. If there is a single point, the second
+     * cluster is empty and has the same center as the first one.
+     */
+    void fit(const dkm_point_seq<2>& points);
+
+    /**
+     * @brief Return the cluster centers of the clustering.
+     */
+    const dkm_point_seq<2>& centroids() const { return this->means; }
+
+    /**
+     * @brief Return the cluster label of each point in the clustering.
+     */
+    const dkm_label_seq& point_labels() const { return this->labels; }
+
+    /**
+     * @brief Return the sum of squared distances of the points to their
+     * cluster centers.
+     */
+    double inertia() const { return this->sse; }
+
+  private:
+    /**
+     * @brief Number of buckets per event used to sort the events.
+     */
+    static constexpr size_t buckets_per_event = 2;
+
+    /**
+     * @brief Direction at which the order of two points changes.
+     */
+    struct Event {
+        /**
+         * @brief Pseudo-angle of the direction in \f$(-1, 1)\f$ that
+         * increases with the angle in \f$(0, \pi)\f$.
+         */
+        double key;
+        /**
+         * @brief Indices of the two points.
+         */
+        uint32_t first, second;
+    };
+
+    /**
+     * @brief Sort unsorted_events by their keys into events.
+     *
+     * Keys are distributed to buckets using counting sort and then sorted
+     * using insertion sort, which takes linear time unless most of the keys
+     * fall into the same bucket.
+     */
+    void sort_events();
+
+    /**
+     * @brief Sort the positions [lo, hi] of order by the projections onto the
+     * direction with the given pseudo-angle and evaluate the splits between
+     * them.
+     */
+    void resort(size_t lo, size_t hi, double key);
+
+    /**
+     * @brief Update the prefix sums of the positions [lo, hi] of order whose
+     * points changed and keep the labels of the best split between them.
+     */
+    void evaluate(size_t lo, size_t hi);
+
+  private:
+    /**
+     * @brief Points centered at their mean.
+     */
+    dkm_point_seq<2> centered;
+    /**
+     * @brief Directions at which the order changes.
+     */
+    std::vector<Event> unsorted_events;
+    /**
+     * @brief Directions at which the order changes sorted by their angles.
+     */
+    std::vector<Event> events;
+    /**
+     * @brief Number of events in each bucket of pseudo-angles.
+     */
+    std::vector<uint32_t> bucket_counts;
+    /**
+     * @brief Point indices sorted by their projections.
+     */
+    std::vector<uint32_t> order;
+    /**
+     * @brief Position of each point in order.
+     */
+    std::vector<uint32_t> position;
+    /**
+     * @brief Projection of each point onto the current direction.
+     */
+    std::vector<double> projections;
+    /**
+     * @brief Prefix sums of x, y and squared norms of the points in order.
+     */
+    std::vector<std::array<double, 3>> prefix;
+    /**
+     * @brief 1 / k for cluster sizes k.
+     */
+    std::vector<double> inverse;
+    /**
+     * @brief Cluster centers of the best clustering.
+     */
+    dkm_point_seq<2> means;
+    /**
+     * @brief Labels of the best clustering.
+     */
+    dkm_label_seq labels;
+    /**
+     * @brief Lowest sum of squared distances found using prefix sums.
+     */
+    double best_sse = std::numeric_limits<double>::max();
+    /**
+     * @brief Sum of squared distances of the best clustering.
+     */
+    double sse = 0;
+};
+
+/**
+ * @brief Calculate the optimal 2-means clustering of the given 2D points and
+ * return it.
+ *
+ * @param points Sequence of dkm_point objects to cluster.
+ *
+ * @return Clustering with the lowest sum of squared distances.
+ */
+dkm_means<2> two_means(const dkm_point_seq<2>& points);
+
+/**
+ * @brief KMeans1D computes the optimal k-means clustering of 1D points using
+ * buffers that are reused between calls.
+ *
+ * Clusters of an optimal 1D k-means clustering are contiguous ranges of the
+ * sorted points. Hence, the clustering can be found using dynamic programming
+ * as in Ckmeans.1d.dp: the lowest sum of squared distances of the first i
+ * sorted points in m clusters is the lowest sum of that of the first j points
+ * in m - 1 clusters and the cost of the points [j, i) as a single cluster.
+ * Costs of the ranges are calculated in \f$O(1)\f$ time using prefix sums;
+ * hence, the clustering is found in \f$O(KN^2)\f$ time, which is faster than
+ * the \f$O(KN)\f$ algorithms for the number of players on the pitch. The
+ * result doesn't depend on any random state. Once the buffers have grown to
+ * the number of points, no memory is allocated.
+ */
+class KMeans1D {
+  public:
+    /**
+     * @brief Calculate the optimal k-means clustering of the given points.
+     *
+     * Cluster labels are given in increasing order of the cluster centers.
+     *
+     * @param points Points to cluster. If there are less than n_clusters
+     * points, some of the clusters are empty.
+     * @param n_clusters Number of clusters to compute in k-means (k).
+     */
+    void fit(const dkm_point_seq<1>& points, uint32_t n_clusters);
+
+    /**
+     * @brief Return the cluster centers of the clustering. Centers of empty
+     * clusters are 0.
+     */
+    const dkm_point_seq<1>& centroids() const { return this->means; }
+
+    /**
+     * @brief Return the cluster label of each point in the clustering.
+     */
+    const dkm_label_seq& point_labels() const { return this->labels; }
+
+    /**
+     * @brief Return the sum of squared distances of the points to their
+     * cluster centers.
+     */
+    double inertia() const { return this->sse; }
+
+  private:
+    /**
+     * @brief Sum of squared distances of the sorted points [j, i) to their
+     * mean.
+     */
+    double range_cost(size_t j, size_t i) const;
+
+  private:
+    /**
+     * @brief Point indices sorted by their values.
+     */
+    std::vector<uint32_t> order;
+    /**
+     * @brief Prefix sums of the centered sorted values.
+     */
+    std::vector<double> sums;
+    /**
+     * @brief Prefix sums of the squares of the centered sorted values.
+     */
+    std::vector<double> squares;
+    /**
+     * @brief 1 / k for cluster sizes k.
+     */
+    std::vector<double> inverse;
+    /**
+     * @brief costs[m * (N + 1) + i] is the lowest sum of squared distances of
+     * the first i sorted points in m + 1 clusters.
+     */
+    std::vector<double> costs;
+    /**
+     * @brief splits[m * (N + 1) + i] is the beginning of the last cluster of
+     * the clustering in costs[m * (N + 1) + i].
+     */
+    std::vector<uint32_t> splits;
+    /**
+     * @brief Cluster centers of the clustering.
+     */
+    dkm_point_seq<1> means;
+    /**
+     * @brief Labels of the clustering.
+     */
+    dkm_label_seq labels;
+    /**
+     * @brief Sum of squared distances of the clustering.
+     */
+    double sse = 0;
+};
+
+/**
+ * @brief Calculate the optimal k-means clustering of the given 1D points and
+ * return it.
+ *
+ * @param points Sequence of dkm_point objects to cluster.
+ * @param n_clusters Number of clusters to compute in k-means (k).
+ *
+ * @return Clustering with the lowest sum of squared distances.
+ */
+dkm_means<1> kmeans_1d(const dkm_point_seq<1>& points, uint32_t n_clusters);
+
 /**
  * @brief Calculate k-means clustering of the given points n_init times and
  * return the clustering with the lowest inertia.
  *
+ * The means are initialized using the given random number engine; hence, the
+ * same points and engine state always give the same clustering.
+ *
  * @tparam N Dimension of the points.
- * @param points Sequence of dkm_point objects that were sent to
- * dkm::kmeans_lloyd clustering algorithm.
+ * @param points Sequence of dkm_point objects to cluster.
  * @param n_clusters Number of clusters to compute in k-means (k).
  * @param n_init Number of times k-means algorithm will be run.
+ * @param engine Random number engine to initialize the means.
  *
  * @return Clustering with the lowest inertia.
  */
 template <size_t N>
+dkm_means<N> kmeans(const dkm_point_seq<N>& points, int n_clusters, int n_init,
+                    kmeans_engine& engine) {
+    KMeans<N> clustering;
+    clustering.fit(points, n_clusters, n_init, engine);
+    return dkm_means<N>(clustering.centroids(), clustering.point_labels());
+}
+
+/**
+ * @brief Same as the function above where the means are initialized using a
+ * random number engine seeded from std::random_device.
+ */
+template <size_t N>
 dkm_means<N> kmeans(const dkm_point_seq<N>& points, int n_clusters,
                     int n_init = 10) {
-    // Run k-means algorithm n_init times and collect the results.
-    std::vector<dkm_means<N>> means_list;
-    for (int i = 0; i < n_init; ++i) {
-        means_list.push_back(dkm::kmeans_lloyd(points, n_clusters));
-    }
-
-    // Return the best k-means result.
-    return get_best_means(points, means_list);
+    kmeans_engine engine(std::random_device{}());
+    return kmeans(points, n_clusters, n_init, engine);
 }
 
 }; // namespace details
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "convex_hull.hpp"
+#include "hull_tracker.hpp"
+#include <utils.hpp>
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief Margin subtracted from the certificates to absorb the rounding
+ * errors of the distances, in metres.
+ */
+static constexpr double certificate_margin = 1e-6;
+
+void HullTracker::update(player_cit begin, player_cit end,
+                         std::vector<int>& order, std::vector<int>& hull) {
+    const size_t n = static_cast<size_t>(std::distance(begin, end));
+
+    // sort the players by their ids using insertion sort; the order of the
+    // players in a range changes between frames
+    this->by_id.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const int index = static_cast<int>(i);
+        size_t j = i;
+        while (j > 0 && begin[this->by_id[j - 1]].id > begin[index].id) {
+            this->by_id[j] = this->by_id[j - 1];
+            --j;
+        }
+        this->by_id[j] = index;
+    }
+
+    // players are the same if the sorted ids are the same and distinct
+    bool same_players = n == this->ids.size();
+    for (size_t k = 0; same_players && k < n; ++k) {
+        const int id = begin[this->by_id[k]].id;
+        same_players = id == this->ids[k] && (k == 0 || id != this->ids[k - 1]);
+    }
+    if (!same_players) {
+        this->ids.resize(n);
+        this->xs.resize(n);
+        this->ys.resize(n);
+        this->sorted.resize(n);
+        for (size_t k = 0; k < n; ++k) {
+            const Player& p = begin[this->by_id[k]];
+            this->ids[k] = p.id;
+            this->xs[k] = p.x;
+            this->ys[k] = p.y;
+            this->sorted[k] = static_cast<int>(k);
+        }
+        const int* by_id = this->by_id.data();
+        std::sort(this->sorted.begin(), this->sorted.end(),
+                  [begin, by_id](int a, int b) {
+                      return position_less(begin, by_id[a], by_id[b]);
+                  });
+        this->rebuild(begin, order, hull);
+        return;
+    }
+
+    // accumulate the distance moved by each player and the hull vertices
+    double vertex_moved = 0;
+    for (size_t k = 0; k < n; ++k) {
+        const Player& p = begin[this->by_id[k]];
+        // Manhattan distance is an upper bound that doesn't need sqrt
+        this->moved[k] +=
+            std::abs(p.x - this->xs[k]) + std::abs(p.y - this->ys[k]);
+        this->xs[k] = p.x;
+        this->ys[k] = p.y;
+        if (this->vertex[k]) {
+            vertex_moved = std::max(vertex_moved, this->moved[k]);
+        }
+    }
+
+    // repair the sorted order using insertion sort, which takes linear time
+    // if only a few players changed places
+    for (size_t i = 1; i < n; ++i) {
+        const int slot = this->sorted[i];
+        size_t j = i;
+        while (j > 0 && position_less(begin, this->by_id[slot],
+                                      this->by_id[this->sorted[j - 1]])) {
+            this->sorted[j] = this->sorted[j - 1];
+            --j;
+        }
+        this->sorted[j] = slot;
+    }
+
+    // players that may not be strictly inside the hull are candidates
+    order.clear();
+    size_t uncertain = 0;
+    for (int k : this->sorted) {
+        if (this->vertex[k]) {
+            order.push_back(this->by_id[k]);
+        } else if (this->certificates[k] <= this->moved[k] + vertex_moved) {
+            order.push_back(this->by_id[k]);
+            ++uncertain;
+        }
+    }
+    if (uncertain > max_uncertain_ratio * (n - this->num_vertices)) {
+        this->rebuild(begin, order, hull);
+        return;
+    }
+    monotone_chain(begin, order, hull);
+}
+
+void HullTracker::rebuild(player_cit begin, std::vector<int>& order,
+                          std::vector<int>& hull) {
+    ++this->num_rebuilds;
+    const size_t n = this->sorted.size();
+    order.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = this->by_id[this->sorted[i]];
+    }
+    monotone_chain(begin, order, hull);
+
+    // slot of each player in the range
+    this->slots.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        this->slots[this->by_id[k]] = static_cast<int>(k);
+    }
+    this->vertex.assign(n, 0);
+    this->certificates.resize(n);
+    this->moved.assign(n, 0);
+    for (int i : hull) {
+        this->vertex[this->slots[i]] = 1;
+    }
+    this->num_vertices = static_cast<size_t>(
+        std::count(this->vertex.begin(), this->vertex.end(), 1));
+
+    // distance to the closest edge of the hull; degenerate hulls have no
+    // inner players
+    const bool degenerate = hull.size() < 3 || hull.front() == hull.back();
+    for (size_t k = 0; k < n; ++k) {
+        if (this->vertex[k] || degenerate) {
+            this->certificates[k] = 0;
+            continue;
+        }
+        const Player& p = begin[this->by_id[k]];
+        double closest = std::numeric_limits<double>::max();
+        for (size_t e = 0; e < hull.size(); ++e) {
+            const Player& a = begin[hull[e]];
+            const Player& b = begin[hull[(e + 1) % hull.size()]];
+            const double length = dist(a.x, a.y, b.x, b.y);
+            closest = std::min(closest, -cross(a, b, p) / length);
+        }
+        this->certificates[k] = std::max(closest - certificate_margin, 0.0);
+    }
+}
+
+}; // namespace details
+}; // namespace feature
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <feature/constants.hpp>
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief HullTracker keeps the convex hull of a Player range up to date across
+ * consecutive frames.
+ *
+ * When the hull is built from scratch, the distance of each player that is not
+ * a hull vertex to the boundary of the hull is stored as its certificate. If
+ * every vertex moved by at most d and a player moved by at most e since then,
+ * the player is still strictly inside the hull of the moved vertices as long
+ * as its certificate is larger than d + e. Hence, in the next frames only the
+ * hull vertices of the last rebuild and the players whose certificates ran out
+ * are passed to the monotone chain, and the hull is repaired from these few
+ * candidates. If many of the players inside the hull lose their certificates,
+ * or the players of the range change, the hull is rebuilt.
+ *
+ * The hull is exactly the same as the one computed by convex_hull. Players are
+ * matched between frames by their ids, so the order of the players in the
+ * range may change from frame to frame; the state of a player is kept in its
+ * slot, which is its position among the players sorted by id. A range with
+ * repeated ids is rebuilt in every frame. Once the buffers have grown to the
+ * number of players, no memory is allocated.
+ */
+class HullTracker {
+  public:
+    /**
+     * @brief Find the convex hull of the given Player range using the state of
+     * the previous call.
+     *
+     * @param begin Beginning of the player range [begin, end).
+     * @param end End of the player range [begin, end).
+     * @param order Buffer to sort the indices of the players.
+     * @param hull Output indices of the players on the convex hull as
+     * computed by convex_hull.
+     */
+    void update(player_cit begin, player_cit end, std::vector<int>& order,
+                std::vector<int>& hull);
+
+    /**
+     * @brief Return the number of times the hull was built from scratch.
+     */
+    size_t rebuilds() const { return this->num_rebuilds; }
+
+  private:
+    /**
+     * @brief Build the hull from all the players in sorted and compute the
+     * certificates of the slots.
+     */
+    void rebuild(player_cit begin, std::vector<int>& order,
+                 std::vector<int>& hull);
+
+  private:
+    /**
+     * @brief Fraction of the players inside the hull that may lose their
+     * certificates before the hull is rebuilt.
+     */
+    static constexpr double max_uncertain_ratio = 0.25;
+
+    /**
+     * @brief Index in the current range of the player of each slot, i.e.
+     * indices of the players sorted by their ids.
+     */
+    std::vector<int> by_id;
+    /**
+     * @brief Slot of each player of the range at the last rebuild.
+     */
+    std::vector<int> slots;
+    /**
+     * @brief Id of the player of each slot in ascending order.
+     */
+    std::vector<int> ids;
+    /**
+     * @brief Coordinates of each slot in the previous frame.
+     */
+    std::vector<double> xs, ys;
+    /**
+     * @brief Slots sorted by the coordinates of their players as in
+     * convex_hull.
+     */
+    std::vector<int> sorted;
+    /**
+     * @brief Whether each slot was a hull vertex at the last rebuild.
+     */
+    std::vector<char> vertex;
+    /**
+     * @brief Number of hull vertices at the last rebuild.
+     */
+    size_t num_vertices = 0;
+    /**
+     * @brief Distance of the player of each slot to the boundary of the hull
+     * at the last rebuild; 0 for hull vertices.
+     */
+    std::vector<double> certificates;
+    /**
+     * @brief Distance the player of each slot moved since the last rebuild.
+     */
+    std::vector<double> moved;
+    /**
+     * @brief Number of times the hull was built from scratch.
+     */
+    size_t num_rebuilds = 0;
+};
+
+}; // namespace details
+}; // namespace feature
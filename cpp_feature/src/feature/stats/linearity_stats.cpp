@@ -14,9 +14,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cmath>
-
-#include <dkm/dkm.hpp>
+#include <limits>
+#include <stdexcept>
 
 #include "dkm_utils.hpp"
 #include "linearity_stats.hpp"
@@ -24,7 +25,7 @@
 namespace feature {
 namespace details {
 
-void linearity_stats(player_cit begin, player_cit end,
+void linearity_stats(player_cit begin, player_cit end, Workspace& workspace,
                      std::vector<double>& features) {
     constexpr int n_clusters = 4;
     double vert_linearity = feature::default_value();
@@ -32,47 +33,62 @@ void linearity_stats(player_cit begin, player_cit end,
     // if we have at least n_clusters many points
     if (std::distance(begin, end) >= n_clusters) {
         // cluster only in x coordinate
-        dkm_point_seq<2> points = players_to_points(begin, end);
-        dkm_point_seq<1> x(points.size());
-        std::transform(
-            points.begin(), points.end(), x.begin(),
-            [](const dkm_point<2>& p) { return dkm_point<1>{p[0]}; });
-        auto means = kmeans(x, n_clusters);
-
-        vert_linearity = max_vertical_linearity(means, x);
+        dkm_point_seq<1>& x = workspace.x_points;
+        x.resize(std::distance(begin, end));
+        std::transform(begin, end, x.begin(), [](const Player& p) {
+            return dkm_point<1>{p.x};
+        });
+
+        workspace.kmeans_1d.fit(x, n_clusters);
+        vert_linearity =
+            max_vertical_linearity(workspace.kmeans_1d.centroids(),
+                                   workspace.kmeans_1d.point_labels(), x);
     }
 
-    features[name_to_index("playerVerticalLinearity")] = vert_linearity;
+    features[feature_index(Team::player, Stat::VerticalLinearity)] =
+        vert_linearity;
+}
+
+void linearity_stats(player_cit begin, player_cit end,
+                     std::vector<double>& features) {
+    Workspace workspace;
+    linearity_stats(begin, end, workspace, features);
 }
 
 double max_vertical_linearity(const dkm_means<1>& means,
                               const dkm_point_seq<1>& points) {
-    // destructure the clustering
-    dkm_point_seq<1> centroids;
-    dkm_label_seq labels;
-    std::tie(centroids, labels) = means;
+    return max_vertical_linearity(std::get<0>(means), std::get<1>(means),
+                                  points);
+}
+
+double max_vertical_linearity(const dkm_point_seq<1>& centroids,
+                              const dkm_label_seq& labels,
+                              const dkm_point_seq<1>& points) {
+    if (points.size() != labels.size())
+        throw std::runtime_error("points and labels have different sizes");
 
     double max_vert_density = std::numeric_limits<double>::lowest();
 
     // for each cluster
     for (size_t curr_label = 0; curr_label < centroids.size(); ++curr_label) {
-        // Center and points of the current cluster
-        dkm_point<1> center = centroids[curr_label];
-        dkm_point_seq<1> cluster = get_cluster(points, labels, curr_label);
+        // Center of the current cluster
+        const dkm_point<1>& center = centroids[curr_label];
+
+        // size of the cluster and the largest distance of a point in the
+        // cluster to the cluster center
+        size_t cluster_size = 0;
+        double max_dist = std::numeric_limits<double>::lowest();
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (labels[i] == curr_label) {
+                ++cluster_size;
+                max_dist = std::max(max_dist, fabs(dist<1>(points[i], center)));
+            }
+        }
 
-        if (cluster.empty()) {
+        if (cluster_size == 0) {
             continue;
         }
 
-        // distance of each point in the cluster to the cluster center
-        std::vector<double> diff(cluster.size(), 0);
-        std::transform(cluster.begin(), cluster.end(), diff.begin(),
-                       [&center](const dkm_point<1>& p) {
-                           return fabs(dist<1>(p, center));
-                       });
-
-        double max_dist = *std::max_element(diff.begin(), diff.end());
-
         // if there is some distance between players
         bool distant_players = max_dist >= 1;
 
@@ -81,9 +97,8 @@ double max_vertical_linearity(const dkm_means<1>& means,
 
         // if no distance, don't calculate vert_density for this cluster
         if (distant_players) {
-            vert_density = cluster.size() / max_dist;
+            vert_density = cluster_size / max_dist;
         }
-
         max_vert_density = std::max(max_vert_density, vert_density);
     }
 
@@ -21,6 +21,7 @@
 #include <feature/constants.hpp>
 
 #include "dkm_utils.hpp"
+#include "workspace.hpp"
 
 namespace feature {
 namespace details {
@@ -28,12 +29,21 @@ namespace details {
 /**
  * @brief Calculate features related to linearity of players.
  *
- * This function calculate playerVerticalLinearity.
+ * This function calculate playerVerticalLinearity. x coordinates of the
+ * players are clustered using the optimal 1D k-means clustering computed by
+ * KMeans1D; hence, the feature doesn't change between runs.
  *
  * @param begin Beginning of Player range [begin, end).
  * @param end End of Player range [begin, end).
+ * @param workspace Buffers to reuse.
  * @param features features vector to write the calculated feature in-place.
  */
+void linearity_stats(player_cit begin, player_cit end, Workspace& workspace,
+                     std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where a new Workspace is used.
+ */
 void linearity_stats(player_cit begin, player_cit end,
                      std::vector<double>& features);
 
@@ -48,5 +58,13 @@ void linearity_stats(player_cit begin, player_cit end,
  */
 double max_vertical_linearity(const dkm_means<1>& means,
                               const dkm_point_seq<1>& points);
+
+/**
+ * @brief Same as the function above where the clustering is given as
+ * separate centroids and labels. No memory is allocated.
+ */
+double max_vertical_linearity(const dkm_point_seq<1>& centroids,
+                              const dkm_label_seq& labels,
+                              const dkm_point_seq<1>& points);
 }; // namespace details
 }; // namespace feature
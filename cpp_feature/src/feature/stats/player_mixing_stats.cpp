@@ -14,7 +14,8 @@
  * limitations under the License.
  */
 
-#include <dkm/dkm.hpp>
+#include <algorithm>
+#include <limits>
 
 #include "dkm_utils.hpp"
 #include "player_mixing_stats.hpp"
@@ -23,46 +24,81 @@ namespace feature {
 namespace details {
 
 void player_mixing_stats(player_cit begin, player_cit end,
-                         std::vector<double>& features) {
+                         const RestartPolicy& restarts, bool warm_start,
+                         Workspace& workspace, std::vector<double>& features) {
     constexpr int n_clusters = 4;
     double max_impurity = feature::default_value();
 
     // if we have at least n_clusters many points
     if (std::distance(begin, end) >= n_clusters) {
         // calculate k-means clustering
-        dkm_point_seq<2> points = players_to_points(begin, end);
-        dkm_point_seq<2> centroids;
-        dkm_label_seq labels;
-        std::tie(centroids, labels) = kmeans(points, n_clusters);
+        players_to_points(begin, end, workspace.points);
+        if (warm_start) {
+            workspace.kmeans_2d.fit_warm(workspace.points, n_clusters,
+                                         restarts, warm_start_tolerance,
+                                         workspace.engine);
+        } else {
+            workspace.kmeans_2d.fit(workspace.points, n_clusters, restarts,
+                                    workspace.engine);
+        }
 
         // player types (home/away/gk/...)
-        std::vector<int> types(std::distance(begin, end));
-        std::transform(begin, end, types.begin(),
+        workspace.types.resize(std::distance(begin, end));
+        std::transform(begin, end, workspace.types.begin(),
                        [](const Player& p) { return p.type; });
 
-        max_impurity = max_cluster_impurity(types, labels, n_clusters);
+        max_impurity = max_cluster_impurity(
+            workspace.types, workspace.kmeans_2d.point_labels(), n_clusters,
+            workspace.type_counts);
     }
 
-    features[name_to_index("maxClusterImpurity")] = max_impurity;
+    features[max_cluster_impurity_id] = max_impurity;
+}
+
+void player_mixing_stats(player_cit begin, player_cit end,
+                         std::vector<double>& features) {
+    Workspace workspace;
+    player_mixing_stats(begin, end, RestartPolicy(), false, workspace,
+                        features);
 }
 
 double max_cluster_impurity(const std::vector<int>& types,
                             const dkm_label_seq& labels, size_t n_clusters) {
+    std::vector<std::pair<int, int>> type_counts;
+    return max_cluster_impurity(types, labels, n_clusters, type_counts);
+}
+
+double max_cluster_impurity(const std::vector<int>& types,
+                            const dkm_label_seq& labels, size_t n_clusters,
+                            std::vector<std::pair<int, int>>& type_counts) {
     double max_impurity = std::numeric_limits<double>::lowest();
 
     // for each cluster
     for (size_t curr_label = 0; curr_label < n_clusters; ++curr_label) {
-        // Team types of players that belong to this cluster.
-        std::vector<int> cluster_types;
+        // count the team types of players that belong to this cluster.
+        type_counts.clear();
+        int cluster_size = 0;
         for (size_t i = 0; i < labels.size(); ++i) {
-            if (labels[i] == curr_label) {
-                cluster_types.push_back(types[i]);
+            if (labels[i] != curr_label) {
+                continue;
+            }
+            ++cluster_size;
+            auto it = std::find_if(
+                type_counts.begin(), type_counts.end(),
+                [&](const std::pair<int, int>& p) { return p.first == types[i]; });
+            if (it == type_counts.end()) {
+                type_counts.emplace_back(types[i], 1);
+            } else {
+                ++it->second;
             }
         }
 
-        // calculate the impurity statistic for the current cluster
-        double impurity = gini_impurity(cluster_types);
-
+        // calculate the Gini impurity of the current cluster
+        double impurity = 0;
+        for (const auto& p : type_counts) {
+            double prob = static_cast<double>(p.second) / cluster_size;
+            impurity += prob * (1 - prob);
+        }
         max_impurity = std::max(max_impurity, impurity);
     }
 
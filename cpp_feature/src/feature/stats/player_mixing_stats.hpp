@@ -16,15 +16,23 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include <feature/constants.hpp>
 
 #include "dkm_utils.hpp"
+#include "workspace.hpp"
 
 namespace feature {
 namespace details {
 
+/**
+ * @brief Relative increase of the inertia of a warm started k-means clustering
+ * after which k-means is restarted from random initializations.
+ */
+constexpr double warm_start_tolerance = 0.1;
+
 /**
  * @brief Calculate features related to how mixed/separated the players are.
  *
@@ -32,8 +40,22 @@ namespace details {
  *
  * @param begin Beginning of Player range [begin, end).
  * @param end End of Player range [begin, end).
+ * @param restarts How many times k-means clustering is run from random
+ * initializations.
+ * @param warm_start If true, k-means clustering starts from the clustering of
+ * the previous call using the same Workspace as in KMeans::fit_warm.
+ * Otherwise, the best of the random initializations is used.
+ * @param workspace Buffers to reuse.
  * @param features features vector to write the calculated feature in-place.
  */
+void player_mixing_stats(player_cit begin, player_cit end,
+                         const RestartPolicy& restarts, bool warm_start,
+                         Workspace& workspace, std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where a new Workspace is used without warm
+ * start, and the best of 10 random initializations is used.
+ */
 void player_mixing_stats(player_cit begin, player_cit end,
                          std::vector<double>& features);
 
@@ -50,5 +72,14 @@ void player_mixing_stats(player_cit begin, player_cit end,
 double max_cluster_impurity(const std::vector<int>& types,
                             const dkm_label_seq& labels, size_t n_clusters);
 
+/**
+ * @brief Same as the function above where the (type, count) pairs of each
+ * cluster are counted in the given buffer. No memory is allocated if the
+ * buffer is large enough.
+ */
+double max_cluster_impurity(const std::vector<int>& types,
+                            const dkm_label_seq& labels, size_t n_clusters,
+                            std::vector<std::pair<int, int>>& type_counts);
+
 }; // namespace details
 }; // namespace feature
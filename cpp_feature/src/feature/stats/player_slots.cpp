@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "player_slots.hpp"
+
+namespace feature {
+namespace details {
+
+void PlayerSlots::clear() {
+    this->ids.clear();
+    this->slots.clear();
+    this->match_id = Row().match_id;
+    this->timestamp = Row().timestamp;
+    this->frame = 0;
+}
+
+size_t PlayerSlots::intern(int id) {
+    // emplace would allocate a node even if the id exists
+    auto it = this->ids.find(id);
+    if (it != this->ids.end()) {
+        return it->second;
+    }
+
+    // never observed before
+    const size_t slot = this->slots.size();
+    this->ids.emplace(id, slot);
+    this->slots.push_back(Slot{id, 0, 0, Row().timestamp, 0});
+    return slot;
+}
+
+void PlayerSlots::prepare(const Row& row, std::vector<size_t>& row_slots) {
+    if (row.match_id != this->match_id) {
+        this->clear();
+        this->match_id = row.match_id;
+    }
+    row_slots.resize(row.players.size());
+    for (size_t i = 0; i < row.players.size(); ++i) {
+        row_slots[i] = this->intern(row.players[i].id);
+    }
+}
+
+void PlayerSlots::record(const Row& row, const std::vector<size_t>& row_slots) {
+    ++this->frame;
+    this->timestamp = row.timestamp;
+    for (size_t i = 0; i < row.players.size(); ++i) {
+        Slot& slot = this->slots[row_slots[i]];
+        if (slot.frame != this->frame) {
+            slot.x = row.players[i].x;
+            slot.y = row.players[i].y;
+            slot.timestamp = row.timestamp;
+            slot.frame = this->frame;
+        }
+    }
+}
+
+void PlayerSlots::record(const Row& row) {
+    this->prepare(row, this->row_slots);
+    this->record(row, this->row_slots);
+}
+
+}; // namespace details
+}; // namespace feature
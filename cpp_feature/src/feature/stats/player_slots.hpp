@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <feature/constants.hpp>
+#include <feature/row.hpp>
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief PlayerSlots maps the tracking ids of the players of a match to dense
+ * slots and keeps the last observed position of each slot.
+ *
+ * Rows of a match are recorded in order. After a Row is recorded, statistics
+ * of the next Row that need the previous positions of its players, such as
+ * speeds, look them up in the slots instead of searching the previous Row.
+ * Slots are cleared when a Row of another match is recorded.
+ */
+class PlayerSlots {
+  public:
+    /**
+     * @brief Last observation of a player.
+     */
+    struct Slot {
+        /**
+         * @brief Tracking id of the player.
+         */
+        int id;
+        /**
+         * @brief Last x coordinate of the player.
+         */
+        double x;
+        /**
+         * @brief Last y coordinate of the player.
+         */
+        double y;
+        /**
+         * @brief Timestamp of the Row the player was last observed in.
+         */
+        long timestamp;
+        /**
+         * @brief Number of the recorded Row the player was last observed in,
+         * starting from 1.
+         */
+        uint64_t frame;
+    };
+
+  public:
+    /**
+     * @brief Forget all the players and the recorded rows.
+     */
+    void clear();
+
+    /**
+     * @brief Return the slot of the player with the given id, creating a new
+     * slot if the id wasn't seen before in the current match.
+     */
+    size_t intern(int id);
+
+    /**
+     * @brief Return the Slot of the given index.
+     */
+    const Slot& operator[](size_t slot) const { return this->slots[slot]; }
+
+    /**
+     * @brief Return the number of slots in the current match.
+     */
+    size_t size() const { return this->slots.size(); }
+
+    /**
+     * @brief Return whether the given slot was observed in the last recorded
+     * Row.
+     */
+    bool in_last_row(size_t slot) const {
+        return this->frame != 0 && this->slots[slot].frame == this->frame;
+    }
+
+    /**
+     * @brief Return the timestamp of the last recorded Row.
+     */
+    long last_timestamp() const { return this->timestamp; }
+
+    /**
+     * @brief Prepare the slots for the given Row: clear them if the Row
+     * belongs to another match and write the slot of each player of the Row.
+     *
+     * @param row Row to be recorded next.
+     * @param row_slots Output slot of each player of the Row.
+     */
+    void prepare(const Row& row, std::vector<size_t>& row_slots);
+
+    /**
+     * @brief Store the positions of the players of the given Row as their
+     * last observations. If an id occurs multiple times, the first occurrence
+     * is stored.
+     *
+     * @param row Row whose slots were written by prepare.
+     * @param row_slots Slot of each player of the Row.
+     */
+    void record(const Row& row, const std::vector<size_t>& row_slots);
+
+    /**
+     * @brief Same as calling prepare and record one after the other.
+     */
+    void record(const Row& row);
+
+  private:
+    /**
+     * @brief Slot of each tracking id of the current match.
+     */
+    std::unordered_map<int, size_t> ids;
+    /**
+     * @brief Last observation of each slot.
+     */
+    std::vector<Slot> slots;
+    /**
+     * @brief Slots of a Row used by record(const Row&).
+     */
+    std::vector<size_t> row_slots;
+    /**
+     * @brief Match id of the recorded rows.
+     */
+    int match_id = Row().match_id;
+    /**
+     * @brief Timestamp of the last recorded Row.
+     */
+    long timestamp = Row().timestamp;
+    /**
+     * @brief Number of recorded rows in the current match.
+     */
+    uint64_t frame = 0;
+};
+
+}; // namespace details
+}; // namespace feature
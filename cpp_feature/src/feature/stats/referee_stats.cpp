@@ -37,9 +37,29 @@ void referee_stats(player_cit ref_begin, player_cit ref_end,
         speed = *speed_it;
     }
 
-    features[name_to_index("refX")] = x;
-    features[name_to_index("refY")] = y;
-    features[name_to_index("refSpeed")] = speed;
+    features[ref_x_id] = x;
+    features[ref_y_id] = y;
+    features[ref_speed_id] = speed;
+}
+
+void referee_stats(const Frame& frame, PlayerSpan referees,
+                   std::vector<double>::const_iterator speed_begin,
+                   std::vector<double>& features) {
+    // default values
+    double x = feature::default_value();
+    double y = feature::default_value();
+    double speed = feature::default_value();
+
+    // if there is a referee
+    if (!referees.empty()) {
+        x = frame.x()[referees.first];
+        y = frame.y()[referees.first];
+        speed = *speed_begin;
+    }
+
+    features[ref_x_id] = x;
+    features[ref_y_id] = y;
+    features[ref_speed_id] = speed;
 }
 
 }; // namespace details
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include <feature/constants.hpp>
+#include <feature/frame.hpp>
 
 namespace feature {
 namespace details {
@@ -33,5 +34,18 @@ namespace details {
 void referee_stats(player_cit ref_begin, player_cit ref_end,
                    std::vector<double>::const_iterator speed_it,
                    std::vector<double>& features);
+
+/**
+ * @brief Same as the function above where the referees are given by a
+ * PlayerSpan of a Frame. The first referee of the span is used.
+ *
+ * @param frame Frame of the players.
+ * @param referees Span of the referees in the frame.
+ * @param speed_begin Iterator pointing to the speed of the first referee.
+ * @param features features vector to write the calculated feature in-place.
+ */
+void referee_stats(const Frame& frame, PlayerSpan referees,
+                   std::vector<double>::const_iterator speed_begin,
+                   std::vector<double>& features);
 }; // namespace details
 }; // namespace feature
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief Maximum number of points small_lloyd can cluster.
+ *
+ * There are at most about 25 players on the pitch; larger inputs use the
+ * generic implementation in KMeans.
+ */
+constexpr size_t small_kmeans_capacity = 32;
+
+#ifdef __SSE2__
+
+/**
+ * @brief Update the given initial means of K clusters using Lloyd's algorithm
+ * until they don't change and write the cluster label of each point.
+ *
+ * This kernel uses fixed-size buffers on the stack; the coordinates are
+ * stored dimension by dimension (structure of arrays) so that the distances
+ * of two points to a mean are computed using SSE2 instructions, and the sums
+ * of the clusters are updated a pair of dimensions at a time. The operations
+ * are done in the same order as in KMeans; hence, the result is the same as
+ * that of the generic implementation to the last bit.
+ *
+ * @tparam N Dimension of the points.
+ * @tparam K Number of clusters.
+ * @param points Points to cluster. There must be at most
+ * small_kmeans_capacity points.
+ * @param means Initial means of size K that are updated in-place. Means of
+ * empty clusters are not changed.
+ * @param labels Output label sequence of the same size as points.
+ */
+template <size_t N, uint32_t K>
+void small_lloyd(const std::vector<std::array<double, N>>& points,
+                 std::vector<std::array<double, N>>& means,
+                 std::vector<uint32_t>& labels) {
+    static_assert(N > 0 && K > 0, "N and K must be positive");
+
+    // coordinates in SoA layout; an odd number of points is padded with the
+    // last point whose label is not written
+    const size_t n = points.size();
+    alignas(16) double coords[N][small_kmeans_capacity];
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+            coords[j][i] = points[i][j];
+        }
+    }
+    if (n % 2 == 1) {
+        for (size_t j = 0; j < N; ++j) {
+            coords[j][n] = coords[j][n - 1];
+        }
+    }
+
+    double curr[K][N];
+    alignas(16) double sums[K][N + N % 2];
+    double counts[K];
+    for (uint32_t m = 0; m < K; ++m) {
+        for (size_t j = 0; j < N; ++j) {
+            curr[m][j] = means[m][j];
+        }
+    }
+
+    // calculate new means until convergence is reached
+    bool changed = true;
+    while (changed) {
+        // index of the closest mean of each pair of points
+        for (size_t i = 0; i < n; i += 2) {
+            __m128d smallest = _mm_setzero_pd();
+            __m128d index = _mm_setzero_pd();
+            for (uint32_t m = 0; m < K; ++m) {
+                __m128d d = _mm_setzero_pd();
+                for (size_t j = 0; j < N; ++j) {
+                    const __m128d delta = _mm_sub_pd(
+                        _mm_load_pd(&coords[j][i]), _mm_set1_pd(curr[m][j]));
+                    d = _mm_add_pd(d, _mm_mul_pd(delta, delta));
+                }
+                if (m == 0) {
+                    smallest = d;
+                    continue;
+                }
+                // keep the first closest mean as in a scalar strict comparison
+                const __m128d closer = _mm_cmplt_pd(d, smallest);
+                smallest = _mm_or_pd(_mm_and_pd(closer, d),
+                                     _mm_andnot_pd(closer, smallest));
+                index = _mm_or_pd(_mm_and_pd(closer, _mm_set1_pd(m)),
+                                  _mm_andnot_pd(closer, index));
+            }
+            alignas(16) double pair_labels[2];
+            _mm_store_pd(pair_labels, index);
+            labels[i] = static_cast<uint32_t>(pair_labels[0]);
+            if (i + 1 < n) {
+                labels[i + 1] = static_cast<uint32_t>(pair_labels[1]);
+            }
+        }
+
+        // sums of the clusters in the order of the points
+        for (uint32_t m = 0; m < K; ++m) {
+            counts[m] = 0;
+            for (size_t j = 0; j < N + N % 2; ++j) {
+                sums[m][j] = 0;
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t label = labels[i];
+            counts[label] += 1;
+            size_t j = 0;
+            for (; j + 1 < N; j += 2) {
+                _mm_store_pd(&sums[label][j],
+                             _mm_add_pd(_mm_load_pd(&sums[label][j]),
+                                        _mm_loadu_pd(&points[i][j])));
+            }
+            for (; j < N; ++j) {
+                sums[label][j] += points[i][j];
+            }
+        }
+
+        // means of the clusters; empty clusters keep their old means
+        changed = false;
+        for (uint32_t m = 0; m < K; ++m) {
+            if (counts[m] == 0) {
+                continue;
+            }
+            size_t j = 0;
+            for (; j + 1 < N; j += 2) {
+                const __m128d mean = _mm_div_pd(_mm_load_pd(&sums[m][j]),
+                                                _mm_set1_pd(counts[m]));
+                const __m128d same =
+                    _mm_cmpeq_pd(mean, _mm_loadu_pd(&curr[m][j]));
+                changed = changed || _mm_movemask_pd(same) != 0x3;
+                _mm_storeu_pd(&curr[m][j], mean);
+            }
+            for (; j < N; ++j) {
+                const double mean = sums[m][j] / counts[m];
+                changed = changed || mean != curr[m][j];
+                curr[m][j] = mean;
+            }
+        }
+    }
+
+    for (uint32_t m = 0; m < K; ++m) {
+        for (size_t j = 0; j < N; ++j) {
+            means[m][j] = curr[m][j];
+        }
+    }
+}
+
+#endif
+
+}; // namespace details
+}; // namespace feature
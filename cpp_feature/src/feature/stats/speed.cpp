@@ -14,7 +14,6 @@
  * limitations under the License.
  */
 
-#include <algorithm>
 #include <vector>
 
 #include <feature/constants.hpp>
@@ -26,28 +25,42 @@ namespace feature {
 namespace details {
 
 std::vector<double> calculate_speeds(const Row& curr, const Row& prev) {
-    // time difference between curr and prev Row objects
-    const int timediff_ms = curr.timestamp - prev.timestamp;
+    std::vector<double> speed;
+    calculate_speeds(curr, prev, speed);
+    return speed;
+}
+
+void calculate_speeds(const Row& curr, const Row& prev,
+                      std::vector<double>& speed) {
+    PlayerSlots slots;
+    std::vector<size_t> row_slots;
+    slots.record(prev);
+    calculate_speeds(curr, slots, row_slots, speed);
+}
+
+void calculate_speeds(const Row& curr, PlayerSlots& slots,
+                      std::vector<size_t>& row_slots,
+                      std::vector<double>& speed) {
+    slots.prepare(curr, row_slots);
+
+    // time difference between curr and the last recorded Row objects
+    const int timediff_ms = curr.timestamp - slots.last_timestamp();
     const double timediff_sec = static_cast<double>(timediff_ms) / 1000;
 
-    std::vector<double> speed(curr.players.size(), feature::default_value());
+    speed.assign(curr.players.size(), feature::default_value());
     for (size_t i = 0; i < curr.players.size(); ++i) {
         const auto& curr_player = curr.players[i];
 
-        // try to find current player in previous Row
-        auto it = std::find_if(prev.players.begin(), prev.players.end(),
-                               [&curr_player](const Player& prev) {
-                                   return curr_player.id == prev.id;
-                               });
-
-        // if player exists, update speed. If not, speed remains as
-        // default_value.
-        if (it != prev.players.end()) {
+        // if player exists in the previous Row, update speed. If not, speed
+        // remains as default_value.
+        if (slots.in_last_row(row_slots[i])) {
+            const PlayerSlots::Slot& prev = slots[row_slots[i]];
             speed[i] =
-                dist(curr_player.x, curr_player.y, it->x, it->y) / timediff_sec;
+                dist(curr_player.x, curr_player.y, prev.x, prev.y) / timediff_sec;
         }
     }
-    return speed;
+
+    slots.record(curr, row_slots);
 }
 
 }; // namespace details
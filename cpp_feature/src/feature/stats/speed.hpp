@@ -21,6 +21,8 @@
 #include <feature/constants.hpp>
 #include <feature/row.hpp>
 
+#include "player_slots.hpp"
+
 namespace feature {
 namespace details {
 
@@ -44,5 +46,34 @@ namespace details {
  */
 std::vector<double> calculate_speeds(const Row& curr, const Row& prev);
 
+/**
+ * @brief Same as the function above where the speeds are written to the given
+ * vector.
+ *
+ * @param curr Current feature::Row object.
+ * @param prev Previous feature::Row object.
+ * @param speed Output speed of each player in current Row, in the same order.
+ */
+void calculate_speeds(const Row& curr, const Row& prev,
+                      std::vector<double>& speed);
+
+/**
+ * @brief Calculate speed of each Player in current Row object using the
+ * positions of the previous Row stored in the given PlayerSlots, and record
+ * the current Row in the slots.
+ *
+ * Previous position of each player is found by a single lookup of its slot;
+ * hence, speeds are calculated in linear time. Speeds are the same as the
+ * ones calculated using the previous Row.
+ *
+ * @param curr Current feature::Row object.
+ * @param slots PlayerSlots whose last recorded Row is the previous Row.
+ * @param row_slots Buffer to store the slot of each player in current Row.
+ * @param speed Output speed of each player in current Row, in the same order.
+ */
+void calculate_speeds(const Row& curr, PlayerSlots& slots,
+                      std::vector<size_t>& row_slots,
+                      std::vector<double>& speed);
+
 }; // namespace details
 }; // namespace feature
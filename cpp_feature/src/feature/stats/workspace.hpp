@@ -0,0 +1,140 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <feature/constants.hpp>
+#include <feature/frame.hpp>
+
+#include "distance_matrix.hpp"
+#include "dkm_utils.hpp"
+#include "hull_tracker.hpp"
+#include "player_slots.hpp"
+
+namespace feature {
+namespace details {
+
+/**
+ * @brief Workspace holds the buffers that are used while computing the
+ * statistics of a single frame.
+ *
+ * A Workspace is reused for consecutive frames so that the buffers are
+ * allocated only while they grow to the largest number of players. A
+ * Workspace must not be used by multiple threads at the same time.
+ */
+struct Workspace {
+    /**
+     * @brief Players of the current frame in structure of arrays layout.
+     */
+    Frame frame;
+    /**
+     * @brief Last positions of the players of the frames computed using this
+     * Workspace.
+     */
+    PlayerSlots player_slots;
+    /**
+     * @brief Slot of each player of the current frame.
+     */
+    std::vector<size_t> row_slots;
+    /**
+     * @brief Speed of each player of the current frame.
+     */
+    std::vector<double> speed;
+    /**
+     * @brief Player x coordinates padded for the pairwise distance kernels.
+     */
+    std::vector<double> xs;
+    /**
+     * @brief Player y coordinates padded for the pairwise distance kernels.
+     */
+    std::vector<double> ys;
+    /**
+     * @brief Distances between the players of the current frame.
+     *
+     * feature::Computer resets the matrix with the players of each frame and
+     * its blocks are computed only when a statistic asks for a distance, so
+     * that all the statistics of the frame share them. distance_stats sums
+     * the distances with pairwise_distance_sum instead, which is faster than
+     * writing them to the matrix.
+     */
+    DistanceMatrix distances;
+    /**
+     * @brief Player coordinates to cluster in 2D.
+     */
+    dkm_point_seq<2> points;
+    /**
+     * @brief Player x coordinates to cluster in 1D.
+     */
+    dkm_point_seq<1> x_points;
+    /**
+     * @brief Player types of the clustered players.
+     */
+    std::vector<int> types;
+    /**
+     * @brief (type, count) pairs of a single cluster.
+     */
+    std::vector<std::pair<int, int>> type_counts;
+    /**
+     * @brief Player indices sorted with respect to their coordinates.
+     */
+    std::vector<int> hull_order;
+    /**
+     * @brief Sorted hull vertices of each team to merge.
+     */
+    std::vector<int> hull_vertices;
+    /**
+     * @brief Indices of the players on the convex hull of each Team of the
+     * current frame, relative to the beginning of the players of that Team.
+     *
+     * Hulls are written by convex_stats and can be used by the other
+     * statistics of the same frame.
+     */
+    std::array<std::vector<int>, static_cast<size_t>(Team::count)> hulls;
+    /**
+     * @brief Whether the convex hulls of the teams are found using
+     * hull_trackers instead of being built from scratch in every frame.
+     */
+    bool track_hulls = false;
+    /**
+     * @brief Convex hull of each Team kept up to date across the consecutive
+     * frames computed using this Workspace when track_hulls is set.
+     */
+    std::array<HullTracker, static_cast<size_t>(Team::count)> hull_trackers;
+    /**
+     * @brief 2D k-means buffers.
+     */
+    KMeans<2> kmeans_2d;
+    /**
+     * @brief Optimal 2-means buffers.
+     */
+    TwoMeans two_means;
+    /**
+     * @brief Optimal 1D k-means buffers.
+     */
+    KMeans1D kmeans_1d;
+    /**
+     * @brief Random number engine to initialize k-means. It is seeded with
+     * the default seed; feature::Computer reseeds it for every frame.
+     */
+    kmeans_engine engine;
+};
+
+}; // namespace details
+}; // namespace feature
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "feature_writer.hpp"
+
+/**
+ * @brief Return the column names of a feature file, i.e. half, minute, second
+ * followed by the given feature names.
+ */
+static std::vector<std::string>
+column_names(const std::vector<std::string>& feature_names) {
+    std::vector<std::string> names{"half", "minute", "second"};
+    names.insert(names.end(), feature_names.begin(), feature_names.end());
+    return names;
+}
+
+/**
+ * @brief Return true if the machine stores integers in little-endian byte
+ * order.
+ */
+static bool little_endian() {
+    const uint16_t value = 1;
+    char first_byte;
+    std::memcpy(&first_byte, &value, 1);
+    return first_byte == 1;
+}
+
+/**
+ * @brief Write the bytes of the given object to the given stream.
+ */
+template <typename T> static void write_raw(std::ofstream& ofs, const T& value) {
+    ofs.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * @brief Open the given filepath for writing in binary mode.
+ *
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+static std::ofstream open_binary(const std::string& filepath) {
+    std::ofstream ofs(filepath, std::ofstream::binary);
+    if (!ofs) {
+        throw std::runtime_error("Cannot open file: " + filepath);
+    }
+    return ofs;
+}
+
+FeatureWriter::~FeatureWriter() {}
+
+CsvFeatureWriter::CsvFeatureWriter(
+    const std::string& filepath, const std::vector<std::string>& feature_names,
+    int precision)
+    : out(filepath, precision) {
+    // write column names
+    auto names = column_names(feature_names);
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (i != 0) {
+            this->out.write(',');
+        }
+        this->out.write(names[i]);
+    }
+    this->out.end_row();
+}
+
+void CsvFeatureWriter::write_row(int half, int minute, int second,
+                                 const std::vector<double>& features) {
+    // write hms
+    this->out.write(half);
+    this->out.write(',');
+    this->out.write(minute);
+    this->out.write(',');
+    this->out.write(second);
+    // write the features
+    for (const double value : features) {
+        this->out.write(',');
+        this->out.write(value);
+    }
+    this->out.end_row();
+}
+
+void CsvFeatureWriter::close() { this->out.flush(); }
+
+NpyFeatureWriter::NpyFeatureWriter(
+    const std::string& filepath, const std::vector<std::string>& feature_names)
+    : file(open_binary(filepath)), descr(), row(), num_rows(0) {
+    // each column is a float64 field of a structured array
+    const std::string type = little_endian() ? "'<f8'" : "'>f8'";
+    auto names = column_names(feature_names);
+    this->descr = "[";
+    for (const auto& name : names) {
+        this->descr += "('" + name + "', " + type + "), ";
+    }
+    this->descr += "]";
+    this->row.reserve(names.size());
+
+    // rows are written after the header; header is rewritten in close
+    this->file << this->header(0);
+}
+
+std::string NpyFeatureWriter::header(uint64_t rows) const {
+    // magic string and version 1.0
+    const std::string preamble("\x93NUMPY\x01\x00", 8);
+    const size_t preamble_size = preamble.size() + sizeof(uint16_t);
+
+    auto dict = [this](const std::string& shape) {
+        return "{'descr': " + this->descr +
+               ", 'fortran_order': False, 'shape': (" + shape + ",), }";
+    };
+
+    // header size must not depend on the number of rows so that it can be
+    // overwritten; reserve space for the largest possible row count. Total
+    // size must be a multiple of 64 for alignment.
+    const size_t max_dict_size = dict(std::to_string(UINT64_MAX)).size();
+    const size_t total_size =
+        (preamble_size + max_dict_size + 1 + 63) / 64 * 64;
+    if (total_size - preamble_size > UINT16_MAX) {
+        throw std::runtime_error("Too many features for .npy header");
+    }
+
+    std::string dict_str = dict(std::to_string(rows));
+    dict_str.resize(total_size - preamble_size - 1, ' ');
+    dict_str += '\n';
+
+    // header length is a little-endian uint16
+    const uint16_t len = static_cast<uint16_t>(dict_str.size());
+    const char len_bytes[2] = {static_cast<char>(len & 0xff),
+                               static_cast<char>(len >> 8)};
+    return preamble + std::string(len_bytes, 2) + dict_str;
+}
+
+void NpyFeatureWriter::write_row(int half, int minute, int second,
+                                 const std::vector<double>& features) {
+    this->row.clear();
+    this->row.push_back(half);
+    this->row.push_back(minute);
+    this->row.push_back(second);
+    this->row.insert(this->row.end(), features.begin(), features.end());
+
+    this->file.write(reinterpret_cast<const char*>(this->row.data()),
+                     this->row.size() * sizeof(double));
+    ++this->num_rows;
+}
+
+void NpyFeatureWriter::close() {
+    // write the final number of rows
+    this->file.seekp(0);
+    this->file << this->header(this->num_rows);
+    this->file.close();
+    if (!this->file) {
+        throw std::runtime_error("Cannot write .npy file");
+    }
+}
+
+ColumnarFeatureWriter::ColumnarFeatureWriter(
+    const std::string& filepath, const std::vector<std::string>& feature_names)
+    : file(open_binary(filepath)), names(column_names(feature_names)),
+      columns(names.size()) {}
+
+void ColumnarFeatureWriter::write_row(int half, int minute, int second,
+                                      const std::vector<double>& features) {
+    this->columns[0].push_back(half);
+    this->columns[1].push_back(minute);
+    this->columns[2].push_back(second);
+    for (size_t i = 0; i < features.size(); ++i) {
+        this->columns[i + 3].push_back(features[i]);
+    }
+}
+
+void ColumnarFeatureWriter::close() {
+    constexpr char magic[8] = {'S', 'I', 'U', 'F', 'E', 'A', 'T', '\0'};
+    constexpr uint32_t version = 1;
+    constexpr size_t header_size = 32;
+
+    // schema is a sequence of (length, name) pairs
+    size_t schema_size = 0;
+    for (const auto& name : this->names) {
+        schema_size += sizeof(uint32_t) + name.size();
+    }
+    const uint64_t data_offset = (header_size + schema_size + 7) / 8 * 8;
+
+    // header
+    this->file.write(magic, sizeof(magic));
+    write_raw(this->file, version);
+    write_raw(this->file, static_cast<uint32_t>(this->columns.size()));
+    write_raw(this->file, static_cast<uint64_t>(this->columns[0].size()));
+    write_raw(this->file, data_offset);
+
+    // schema
+    for (const auto& name : this->names) {
+        write_raw(this->file, static_cast<uint32_t>(name.size()));
+        this->file.write(name.data(), name.size());
+    }
+    const std::string padding(data_offset - header_size - schema_size, '\0');
+    this->file.write(padding.data(), padding.size());
+
+    // columns
+    for (const auto& column : this->columns) {
+        this->file.write(reinterpret_cast<const char*>(column.data()),
+                         column.size() * sizeof(double));
+    }
+
+    this->file.close();
+    if (!this->file) {
+        throw std::runtime_error("Cannot write columnar feature file");
+    }
+}
+
+std::unique_ptr<FeatureWriter>
+make_feature_writer(const std::string& format, const std::string& filepath,
+                    const std::vector<std::string>& feature_names,
+                    int precision) {
+    if (format == "csv") {
+        return std::unique_ptr<FeatureWriter>(
+            new CsvFeatureWriter(filepath, feature_names, precision));
+    } else if (format == "npy") {
+        return std::unique_ptr<FeatureWriter>(
+            new NpyFeatureWriter(filepath, feature_names));
+    } else if (format == "columnar") {
+        return std::unique_ptr<FeatureWriter>(
+            new ColumnarFeatureWriter(filepath, feature_names));
+    }
+    throw std::runtime_error("Unknown output format: " + format);
+}
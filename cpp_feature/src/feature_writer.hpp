@@ -0,0 +1,218 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "csv_writer.hpp"
+
+/**
+ * @brief FeatureWriter writes the features computed for each second of a match
+ * to a file.
+ *
+ * Each row written by a FeatureWriter consists of half, minute and second of
+ * the row followed by the features in the order of feature::feature_list().
+ * Derived classes implement different output file formats.
+ */
+class FeatureWriter {
+  public:
+    /**
+     * @brief Destructor.
+     */
+    virtual ~FeatureWriter();
+
+    /**
+     * @brief Write a row of features.
+     *
+     * @param half Half of the row.
+     * @param minute Minute of the row.
+     * @param second Second of the row.
+     * @param features Features of the row.
+     */
+    virtual void write_row(int half, int minute, int second,
+                           const std::vector<double>& features) = 0;
+
+    /**
+     * @brief Write any remaining data and close the file.
+     *
+     * No rows can be written after the writer is closed.
+     *
+     * @throws std::runtime_error if the data cannot be written.
+     */
+    virtual void close() = 0;
+};
+
+/**
+ * @brief FeatureWriter that writes a CSV file with a header row.
+ */
+class CsvFeatureWriter : public FeatureWriter {
+  public:
+    /**
+     * @brief Open the CSV file and write the header row.
+     *
+     * @param filepath Path to the CSV file.
+     * @param feature_names Names of the features.
+     * @param precision Number of digits to write after the decimal point, or
+     * CsvWriter::shortest.
+     */
+    CsvFeatureWriter(const std::string& filepath,
+                     const std::vector<std::string>& feature_names,
+                     int precision);
+
+    void write_row(int half, int minute, int second,
+                   const std::vector<double>& features) override;
+
+    void close() override;
+
+  private:
+    /**
+     * @brief Buffered CSV writer.
+     */
+    CsvWriter out;
+};
+
+/**
+ * @brief FeatureWriter that writes a NumPy .npy file.
+ *
+ * The file holds a one dimensional structured array with a float64 field for
+ * half, minute, second and each feature. Hence, the column names are stored in
+ * the file, and the file can be loaded (or memory-mapped) using numpy.load:
+ * @code
+ *     arr = np.load('123_feature.npy', mmap_mode='r')
+ *     df = pd.DataFrame(arr)
+ *     matrix = arr.view('<f8').reshape(len(arr), -1)
+ * @endcode
+ *
+ * Rows are written to the file as they are computed; the number of rows in the
+ * header is updated when the writer is closed.
+ */
+class NpyFeatureWriter : public FeatureWriter {
+  public:
+    /**
+     * @brief Open the .npy file and write a header with zero rows.
+     *
+     * @param filepath Path to the .npy file.
+     * @param feature_names Names of the features.
+     */
+    NpyFeatureWriter(const std::string& filepath,
+                     const std::vector<std::string>& feature_names);
+
+    void write_row(int half, int minute, int second,
+                   const std::vector<double>& features) override;
+
+    void close() override;
+
+  private:
+    /**
+     * @brief Return the .npy header for the given number of rows.
+     */
+    std::string header(uint64_t num_rows) const;
+
+  private:
+    /**
+     * @brief Output file.
+     */
+    std::ofstream file;
+    /**
+     * @brief Array description (descr) of the .npy header.
+     */
+    std::string descr;
+    /**
+     * @brief Row buffer holding half, minute, second and features.
+     */
+    std::vector<double> row;
+    /**
+     * @brief Number of rows written so far.
+     */
+    uint64_t num_rows;
+};
+
+/**
+ * @brief FeatureWriter that writes a column-per-feature binary file.
+ *
+ * The file starts with a 32 byte header:
+ *
+ * Offset | Type     | Field
+ * ------ | -------- | -----
+ * 0      | char[8]  | magic, "SIUFEAT\0"
+ * 8      | uint32   | version, 1
+ * 12     | uint32   | num_columns
+ * 16     | uint64   | num_rows
+ * 24     | uint64   | data_offset
+ *
+ * The header is followed by the schema: for each column, a uint32 name length
+ * followed by the name bytes. Column data starts at data_offset, which is a
+ * multiple of 8. Each column is stored as num_rows consecutive float64 values,
+ * and columns are stored one after another in the order of the schema. All
+ * values are stored in the native byte order of the machine.
+ *
+ * Since the columns are contiguous, rows are kept in memory until the writer
+ * is closed.
+ */
+class ColumnarFeatureWriter : public FeatureWriter {
+  public:
+    /**
+     * @brief Open the file for writing.
+     *
+     * @param filepath Path to the output file.
+     * @param feature_names Names of the features.
+     */
+    ColumnarFeatureWriter(const std::string& filepath,
+                          const std::vector<std::string>& feature_names);
+
+    void write_row(int half, int minute, int second,
+                   const std::vector<double>& features) override;
+
+    void close() override;
+
+  private:
+    /**
+     * @brief Output file.
+     */
+    std::ofstream file;
+    /**
+     * @brief Names of all the columns.
+     */
+    std::vector<std::string> names;
+    /**
+     * @brief Values of each column.
+     */
+    std::vector<std::vector<double>> columns;
+};
+
+/**
+ * @brief Create a FeatureWriter for the given output format.
+ *
+ * @param format One of "csv", "npy" or "columnar".
+ * @param filepath Path to the output file.
+ * @param feature_names Names of the features.
+ * @param precision Number of digits after the decimal point used by the CSV
+ * format, or CsvWriter::shortest.
+ *
+ * @return A FeatureWriter writing the given format.
+ *
+ * @throws std::runtime_error if the format is unknown or the file cannot be
+ * opened.
+ */
+std::unique_ptr<FeatureWriter>
+make_feature_writer(const std::string& format, const std::string& filepath,
+                    const std::vector<std::string>& feature_names,
+                    int precision);
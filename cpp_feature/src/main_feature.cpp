@@ -14,39 +14,154 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
 #include <fstream>
-#include <iomanip>
+#include <future>
 #include <iostream>
-#include <sstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <dirent.h>
+#include <glob.h>
+#include <sys/stat.h>
+
+#include "csv_writer.hpp"
+#include "double_format.hpp"
 #include "feature_computation.hpp"
-#include "parser.hpp"
+#include "feature_writer.hpp"
+#include "raw_binary.hpp"
+#include "raw_reader.hpp"
+#include "thread_pool.hpp"
 #include "utils.hpp"
 
 /**
  * @brief Atomic variable that holds the last signal sent to this program.
  *
  * This variable is used to detect interrupts by the user and exit the
- * program gracefully.
+ * program gracefully. It is read by all the worker threads in batch mode.
  */
-static std::sig_atomic_t g_signal_status;
+static std::atomic<std::sig_atomic_t> g_signal_status{0};
 
 /**
- * @brief Convert the given half, minute, second triple to a unique second
- * value.
- *
- * @param half Half of the match.
- * @param minute minute of the match.
- * @param second second of the match.
- *
- * @return A unique second value corresponding to given (h, m, s) triple.
+ * @brief What to do with malformed frames of text raw data files.
  */
-static size_t hms(size_t half, size_t minute, size_t second) {
-    return 3600 * half + 60 * minute + second;
-}
+enum class MalformedPolicy {
+    /**
+     * @brief Stop processing the match at the first malformed frame.
+     */
+    abort,
+    /**
+     * @brief Skip malformed frames and report how many were skipped.
+     */
+    skip,
+    /**
+     * @brief Skip malformed frames, report how many were skipped and exit
+     * with an error status if any frame is skipped.
+     */
+    count
+};
+
+/**
+ * @brief Features written for a match and malformed frames skipped while
+ * reading it.
+ */
+struct MatchSummary {
+    /**
+     * @brief Number of feature rows written.
+     */
+    size_t num_rows = 0;
+    /**
+     * @brief Number of malformed frames skipped.
+     */
+    size_t num_malformed = 0;
+};
+
+/**
+ * @brief Command line options of the program.
+ */
+struct Options {
+    /**
+     * @brief Relative filepath to the raw player coordinate data.
+     */
+    std::string raw_filepath;
+    /**
+     * @brief Relative filepath to output feature data.
+     */
+    std::string feature_filepath;
+    /**
+     * @brief Number of digits after the decimal point to write for each
+     * feature, or CsvWriter::shortest.
+     */
+    int precision = 12;
+    /**
+     * @brief Output file format; one of csv, npy or columnar.
+     */
+    std::string format = "csv";
+    /**
+     * @brief Number of threads to compute the features of a single match.
+     * If 0, the number of hardware threads is used for a single match and 1
+     * is used in batch mode.
+     */
+    size_t threads = 0;
+    /**
+     * @brief Seed of the random number engine used by k-means clusterings.
+     */
+    uint64_t seed = 0;
+    /**
+     * @brief Whether k-means clusterings start from the clustering of the
+     * previous frame.
+     */
+    bool warm_start = false;
+    /**
+     * @brief How many times k-means clusterings are run from random
+     * initializations.
+     */
+    feature::details::RestartPolicy restarts;
+    /**
+     * @brief Whether the convex hulls of the teams are tracked across frames
+     * instead of being built from scratch.
+     */
+    bool track_hulls = false;
+    /**
+     * @brief What to do with malformed frames.
+     */
+    MalformedPolicy on_malformed = MalformedPolicy::abort;
+    /**
+     * @brief Whether multiple matches are processed in batch mode.
+     */
+    bool batch = false;
+    /**
+     * @brief Number of matches to process concurrently in batch mode. If 0,
+     * the number of hardware threads is used.
+     */
+    size_t jobs = 0;
+    /**
+     * @brief Directory to write the feature files in batch mode.
+     */
+    std::string output_dir;
+    /**
+     * @brief Raw data files, directories, glob patterns or @manifest files
+     * to process in batch mode.
+     */
+    std::vector<std::string> inputs;
+};
+
+/**
+ * @brief Number of rows per thread whose features are computed together when a
+ * single match is computed using multiple threads.
+ */
+static const size_t rows_per_thread = 64;
 
 /**
  * @brief Flip x coordinates of all players in the given row so that players in
@@ -66,6 +181,102 @@ static void flip_players(feature::Row& row) {
     }
 }
 
+/**
+ * @brief Computes one second apart features from the frames of the given raw
+ * data reader and writes them to the output file.
+ *
+ * Only the first frame of each second is used; the remaining frames of the
+ * same second are skipped by the reader.
+ *
+ * @tparam Reader RawReader or BinaryRawReader.
+ * @param reader Reader of the raw player coordinate data.
+ * @param feature_filepath Path to the output feature file.
+ * @param options Command line options.
+ *
+ * @return Number of feature rows written.
+ */
+template <typename Reader>
+static size_t features_from_reader(Reader& reader,
+                                   const std::string& feature_filepath,
+                                   const Options& options) {
+    // feature data is written to the file as it is computed
+    std::unique_ptr<FeatureWriter> out =
+        make_feature_writer(options.format, feature_filepath,
+                            feature::feature_list(), options.precision);
+
+    feature::Computer fc(options.seed, options.warm_start, options.restarts,
+                         options.track_hulls);
+    const bool converted = reader.converted();
+    const bool home_left = reader.home_left();
+
+    // read the first frame of the next second; the rest are skipped.
+    auto read_row = [&reader, converted, home_left](feature::Row& row) {
+        if (!reader.next_second(row)) {
+            return false;
+        }
+        // if the x values are not converted, we need to do manual flipping.
+        if (!converted) {
+            if ((home_left && row.half == 2) || (!home_left && row.half == 1)) {
+                flip_players(row);
+            }
+        }
+        return true;
+    };
+
+    size_t num_rows = 0;
+    if (options.threads <= 1) {
+        // row and features are reused for every frame to avoid reallocating
+        // players and features.
+        feature::Row row;
+        std::vector<double> features;
+        while (read_row(row)) {
+            // if we have SIGINT
+            if (g_signal_status == SIGINT) {
+                return num_rows;
+            }
+
+            // compute features
+            fc.compute_features(row, features);
+
+            out->write_row(row.half, row.minute, row.second, features);
+            ++num_rows;
+        }
+    } else {
+        // features of a block of rows are computed in parallel. Rows of the
+        // block are reused to avoid reallocating players.
+        ThreadPool pool(options.threads);
+        std::vector<feature::Row> block(rows_per_thread * pool.size());
+        bool more_rows = true;
+        while (more_rows) {
+            size_t block_size = 0;
+            while (block_size < block.size() && read_row(block[block_size])) {
+                ++block_size;
+            }
+            // last block
+            if (block_size < block.size()) {
+                block.resize(block_size);
+                more_rows = false;
+            }
+            // if we have SIGINT
+            if (g_signal_status == SIGINT) {
+                return num_rows;
+            }
+
+            // compute features
+            auto features = fc.compute_features(block, pool);
+
+            for (size_t i = 0; i < block.size(); ++i) {
+                const feature::Row& row = block[i];
+                out->write_row(row.half, row.minute, row.second, features[i]);
+            }
+            num_rows += block.size();
+        }
+    }
+
+    out->close();
+    return num_rows;
+}
+
 /**
  * @brief Computes one second apart features from unsmoothed, 100 millisecond
  * apart raw player coordinate data.
@@ -76,75 +287,297 @@ static void flip_players(feature::Row& row) {
  *
  * The format of the given raw file must be exactly as described in
  * feature_construction.ipynb notebook under notebooks directory of this
- * repository. In this format, a raw coordinate data contains player coordinates
- * for every 100 ms of the match. However, this function computes features for
- * every 1000 ms (1 second). This is done by considering only the first data
- * point in all 10 points for a given second.
+ * repository, or it must be a binary raw file produced by raw2bin. In this
+ * format, a raw coordinate data contains player coordinates for every 100 ms
+ * of the match. However, this function computes features for every 1000 ms (1
+ * second). This is done by considering only the first data point in all 10
+ * points for a given second.
+ *
+ * If the program is interrupted, the partially written output file is removed.
+ * Malformed frames of a text raw data file are handled according to
+ * options.on_malformed. Binary raw files are validated when they are opened;
+ * hence, they don't contain malformed frames.
  *
- * @param raw_filepath Relative filepath to the raw player coordinate data.
- * @param feature_filepath Relative filepath to output feature data.
+ * @param raw_filepath Path to the raw data.
+ * @param feature_filepath Path to the output feature file.
+ * @param options Command line options.
+ *
+ * @return Number of feature rows written and malformed frames skipped.
  */
-static void features_from_raw(const std::string& raw_filepath,
-                              const std::string& feature_filepath) {
-    // feature data buffer
-    std::ostringstream out;
-
-    // write feature names
-    auto feature_names = feature::feature_list();
-    out << "half,minute,second";
-    for (const auto& name : feature_names) {
-        out << "," << name;
+static MatchSummary features_from_raw(const std::string& raw_filepath,
+                                      const std::string& feature_filepath,
+                                      const Options& options) {
+    MatchSummary summary;
+    if (is_raw_binary(raw_filepath)) {
+        BinaryRawReader reader(raw_filepath);
+        summary.num_rows =
+            features_from_reader(reader, feature_filepath, options);
+    } else {
+        RawReader reader(raw_filepath,
+                         options.on_malformed != MalformedPolicy::abort);
+        summary.num_rows =
+            features_from_reader(reader, feature_filepath, options);
+        summary.num_malformed = reader.malformed();
     }
-    out << '\n';
 
-    std::string line;
-    feature::Computer fc;
-    size_t prev_hms = hms(1, 0, -1);
+    if (g_signal_status == SIGINT) {
+        std::remove(feature_filepath.c_str());
+    }
+    return summary;
+}
 
-    // read boolean values
-    std::ifstream in(raw_filepath);
-    bool converted, home_left;
-    in >> converted >> home_left;
+/**
+ * @brief Check whether the given path is a directory.
+ */
+static bool is_directory(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
 
-    // flush newline
-    std::getline(in, line);
+/**
+ * @brief Check whether the given filename is of the form <id>_rawdata.txt or
+ * <id>_rawdata.bin.
+ */
+static bool is_raw_filename(const std::string& name) {
+    const std::string suffix = "_rawdata.";
+    const size_t pos = name.rfind(suffix);
+    if (pos == std::string::npos || pos == 0) {
+        return false;
+    }
+    const std::string ext = name.substr(pos + suffix.size());
+    if (ext != "txt" && ext != "bin") {
+        return false;
+    }
+    return std::all_of(name.begin(), name.begin() + pos,
+                       [](char c) { return c >= '0' && c <= '9'; });
+}
 
-    while (std::getline(in, line)) {
-        // if we have SIGINT
-        if (g_signal_status == SIGINT) {
-            std::cerr << "\nInterrupt: Exiting program" << std::endl;
-            return;
-        }
-        // compute features
-        feature::Row row = parse_line(line);
-        size_t curr_hms = hms(row.half, row.minute, row.second);
-        if (curr_hms != prev_hms) {
-            // if the x values are not converted, we need to do manual flipping.
-            if (!converted) {
-                if ((home_left && row.half == 2) ||
-                    (!home_left && row.half == 1)) {
-                    flip_players(row);
+/**
+ * @brief Expand batch mode inputs to a list of raw data files.
+ *
+ * Each input is handled as follows:
+ *
+ * 1. A directory is expanded to all the <id>_rawdata.txt and
+ *    <id>_rawdata.bin files inside it. If both files of a match are in the
+ *    directory, only <id>_rawdata.bin is used.
+ * 2. @path is a manifest file containing one raw data path per line. Empty
+ *    lines and lines starting with # are ignored.
+ * 3. An input containing any of *?[ characters is expanded as a glob pattern.
+ * 4. Anything else is taken as a raw data path.
+ *
+ * @param inputs Batch mode inputs.
+ *
+ * @return Raw data paths in the order of the inputs. Directory and glob
+ * results are sorted.
+ *
+ * @throws std::runtime_error if a directory or a manifest cannot be read.
+ */
+static std::vector<std::string>
+collect_raw_files(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        if (input.size() > 1 && input[0] == '@') {
+            std::ifstream manifest(input.substr(1));
+            if (!manifest) {
+                throw std::runtime_error("Cannot open manifest: " +
+                                         input.substr(1));
+            }
+            std::string line;
+            while (std::getline(manifest, line)) {
+                rtrim(line);
+                if (!line.empty() && line[0] != '#') {
+                    files.push_back(line);
+                }
+            }
+        } else if (is_directory(input)) {
+            DIR* dir = opendir(input.c_str());
+            if (dir == nullptr) {
+                throw std::runtime_error("Cannot open directory: " + input);
+            }
+            std::vector<std::string> names;
+            while (const dirent* entry = readdir(dir)) {
+                if (is_raw_filename(entry->d_name)) {
+                    names.push_back(entry->d_name);
+                }
+            }
+            closedir(dir);
+            // <id>_rawdata.bin sorts right before <id>_rawdata.txt
+            std::sort(names.begin(), names.end());
+            for (size_t i = 0; i < names.size(); ++i) {
+                const std::string& name = names[i];
+                const size_t ext = name.size() - 3;
+                if (i != 0 && name.compare(ext, 3, "txt") == 0 &&
+                    names[i - 1].compare(0, ext, name, 0, ext) == 0) {
+                    continue;
                 }
+                files.push_back(input + "/" + name);
+            }
+        } else if (input.find_first_of("*?[") != std::string::npos) {
+            glob_t matches;
+            if (glob(input.c_str(), 0, nullptr, &matches) == 0) {
+                files.insert(files.end(), matches.gl_pathv,
+                             matches.gl_pathv + matches.gl_pathc);
             }
+            globfree(&matches);
+        } else {
+            files.push_back(input);
+        }
+    }
+    return files;
+}
 
-            auto features = fc.compute_features(row);
+/**
+ * @brief Return the path of the feature file for the given raw data file in
+ * batch mode.
+ *
+ * The feature file of <dir>/<id>_rawdata.txt is <output_dir>/<id>_feature.csv
+ * where the extension is the name of the output format. If the raw filename
+ * doesn't contain an underscore, the whole filename without its extension is
+ * used as the match id.
+ *
+ * @param raw_filepath Path to the raw data.
+ * @param options Command line options.
+ *
+ * @return Path to the output feature file.
+ */
+static std::string batch_feature_filepath(const std::string& raw_filepath,
+                                          const Options& options) {
+    const size_t slash = raw_filepath.rfind('/');
+    const std::string name = (slash == std::string::npos)
+                                 ? raw_filepath
+                                 : raw_filepath.substr(slash + 1);
+    size_t id_end = name.rfind('_');
+    if (id_end == std::string::npos) {
+        id_end = name.rfind('.');
+    }
+    return options.output_dir + "/" + name.substr(0, id_end) + "_feature." +
+           options.format;
+}
 
-            // write hms
-            out << row.half << "," << row.minute << "," << row.second;
-            // write the features
-            for (const double value : features) {
-                out << "," << std::fixed << std::setprecision(12) << value;
-            }
-            out << '\n';
+/**
+ * @brief Check that no two raw data files write to the same feature file in
+ * batch mode.
+ *
+ * @param raw_files Raw data paths.
+ * @param options Command line options.
+ *
+ * @throws std::runtime_error if two raw data files have the same feature file.
+ */
+static void check_feature_filepaths(const std::vector<std::string>& raw_files,
+                                    const Options& options) {
+    std::map<std::string, std::string> raw_of_feature;
+    for (const auto& raw_filepath : raw_files) {
+        const auto inserted = raw_of_feature.emplace(
+            batch_feature_filepath(raw_filepath, options), raw_filepath);
+        if (!inserted.second) {
+            throw std::runtime_error(
+                "Both " + inserted.first->second + " and " + raw_filepath +
+                " would be written to " + inserted.first->first);
+        }
+    }
+}
 
-            // update prev_hms
-            prev_hms = curr_hms;
+/**
+ * @brief Computes features for all the matches given in batch mode inputs
+ * concurrently.
+ *
+ * Each match is processed on a worker of a ThreadPool with its own
+ * feature::Computer. Start, completion and errors of each match are reported
+ * separately; an error in one match doesn't stop the others. The number of
+ * malformed frames skipped in all the matches is reported at the end.
+ *
+ * @param options Command line options.
+ *
+ * @return true if all the matches are processed; false if a match could not be
+ * processed, or a frame is skipped with MalformedPolicy::count.
+ */
+static bool batch_features_from_raw(const Options& options) {
+    const std::vector<std::string> raw_files =
+        collect_raw_files(options.inputs);
+    if (raw_files.empty()) {
+        throw std::runtime_error("No raw data files found");
+    }
+    check_feature_filepaths(raw_files, options);
+    if (!is_directory(options.output_dir) &&
+        mkdir(options.output_dir.c_str(), 0777) != 0) {
+        throw std::runtime_error("Cannot create output directory: " +
+                                 options.output_dir);
+    }
+
+    std::mutex report_mutex;
+    auto report = [&report_mutex](std::ostream& os, const std::string& msg) {
+        std::lock_guard<std::mutex> lock(report_mutex);
+        os << msg << std::endl;
+    };
+
+    const size_t total = raw_files.size();
+    std::atomic<size_t> num_done{0};
+    std::atomic<size_t> num_failed{0};
+    std::atomic<size_t> num_malformed{0};
+    {
+        // at most one worker per match
+        const size_t jobs = (options.jobs != 0)
+                                ? options.jobs
+                                : std::thread::hardware_concurrency();
+        ThreadPool pool(std::min(jobs, total));
+        for (const auto& raw_filepath : raw_files) {
+            pool.submit([&, raw_filepath]() {
+                if (g_signal_status == SIGINT) {
+                    ++num_failed;
+                    return;
+                }
+                const std::string feature_filepath =
+                    batch_feature_filepath(raw_filepath, options);
+                report(std::cout, "Processing " + raw_filepath);
+                const auto start = std::chrono::steady_clock::now();
+                try {
+                    const MatchSummary summary = features_from_raw(
+                        raw_filepath, feature_filepath, options);
+                    if (g_signal_status == SIGINT) {
+                        ++num_failed;
+                        return;
+                    }
+                    num_malformed += summary.num_malformed;
+                    const std::chrono::duration<double> elapsed =
+                        std::chrono::steady_clock::now() - start;
+                    const std::string skipped =
+                        (summary.num_malformed == 0)
+                            ? ""
+                            : " (" + std::to_string(summary.num_malformed) +
+                                  " malformed frames skipped)";
+                    report(std::cout,
+                           "[" + std::to_string(++num_done) + "/" +
+                               std::to_string(total) + "] " + raw_filepath +
+                               " -> " + feature_filepath + ": " +
+                               std::to_string(summary.num_rows) + " rows" +
+                               skipped + " in " +
+                               std::to_string(elapsed.count()) + " s");
+                } catch (const std::exception& e) {
+                    ++num_failed;
+                    std::remove(feature_filepath.c_str());
+                    report(std::cerr,
+                           "[" + std::to_string(++num_done) + "/" +
+                               std::to_string(total) + "] Error: " +
+                               raw_filepath + ": " + e.what());
+                }
+            });
         }
+        // pool destructor waits for all the matches
     }
 
-    // write the computed features to output file
-    std::ofstream feature_file(feature_filepath);
-    feature_file << out.str();
+    if (g_signal_status == SIGINT) {
+        std::cerr << "\nInterrupt: Exiting program" << std::endl;
+    }
+    if (num_failed != 0) {
+        std::cerr << num_failed << " of " << total
+                  << " matches could not be processed" << std::endl;
+    }
+    if (num_malformed != 0) {
+        std::cerr << num_malformed << " malformed frames skipped" << std::endl;
+    }
+    return num_failed == 0 &&
+           (num_malformed == 0 ||
+            options.on_malformed != MalformedPolicy::count);
 }
 
 /**
@@ -165,8 +598,10 @@ static void signal_setter(int signal) { g_signal_status = signal; }
 static void print_usage(std::ostream& os, const std::string& program_name) {
     os << "feature" << std::endl;
     os << "=======" << std::endl;
-    os << "Usage: " << program_name << " <rawdata_path> <out_feature_path>"
-       << std::endl
+    os << "Usage: " << program_name
+       << " [options] <rawdata_path> <out_feature_path>" << std::endl
+       << "       " << program_name
+       << " [options] --batch <out_dir> <input>..." << std::endl
        << std::endl;
     os << "Reads raw data from the given file in <rawdata_path> and"
           "\ncomputes features for each second of the game."
@@ -177,29 +612,217 @@ static void print_usage(std::ostream& os, const std::string& program_name) {
     os << std::endl;
     os << "To learn more about raw data format, refer to\n"
        << "feature_construction.ipynb" << std::endl;
+    os << std::endl;
+    os << "<rawdata_path> may also be a binary raw file created by raw2bin."
+       << std::endl;
+    os << std::endl;
+    os << "Options:" << std::endl;
+    os << "  --precision <N>  Write features with N digits after the\n"
+       << "                   decimal point (default: 12)." << std::endl;
+    os << "  --shortest       Write features using the shortest\n"
+       << "                   representation that round trips." << std::endl;
+    os << "  --format <F>     Output format: csv (default), npy or\n"
+       << "                   columnar. npy files can be loaded with\n"
+       << "                   numpy.load; refer to read_feature_npy and\n"
+       << "                   read_feature_columnar in notebooks/utils.py."
+       << std::endl;
+    os << "  --batch          Compute features of all the matches in the\n"
+       << "                   inputs concurrently and write them to\n"
+       << "                   <out_dir>/<id>_feature.<format>. An input\n"
+       << "                   is a raw data file, a directory containing\n"
+       << "                   <id>_rawdata.txt or <id>_rawdata.bin files,\n"
+       << "                   a quoted glob pattern, or @<manifest> with\n"
+       << "                   one raw data path per line." << std::endl;
+    os << "  --jobs <N>       Number of matches to process concurrently in\n"
+       << "                   batch mode (default: number of cores)."
+       << std::endl;
+    os << "  --threads <N>    Number of threads to compute the features of\n"
+       << "                   each match (default: number of cores, or 1\n"
+       << "                   in batch mode)." << std::endl;
+    os << "  --seed <N>       Seed of the random k-means initializations\n"
+       << "                   (default: 0). The same input and seed give\n"
+       << "                   the same features." << std::endl;
+    os << "  --warm-start     Start k-means clusterings from the clusters\n"
+       << "                   of the previous frame and restart them only\n"
+       << "                   if they get worse." << std::endl;
+    os << "  --kmeans-restarts <N>\n"
+       << "                   Maximum number of random k-means\n"
+       << "                   initializations (default: 10)." << std::endl;
+    os << "  --kmeans-patience <N>\n"
+       << "                   Stop k-means initializations after N\n"
+       << "                   consecutive ones don't lower the inertia\n"
+       << "                   (default: 0, never stop early)." << std::endl;
+    os << "  --track-hulls    Repair the convex hulls of the teams from the\n"
+       << "                   previous frame instead of rebuilding them.\n"
+       << "                   Meant for high-rate (e.g. 10 Hz) data."
+       << std::endl;
+    os << "  --malformed <P>  What to do with malformed frames: abort\n"
+       << "                   (default) stops at the first one, skip\n"
+       << "                   skips them and reports how many were\n"
+       << "                   skipped, count also exits with an error\n"
+       << "                   status if any frame is skipped." << std::endl;
+}
+
+/**
+ * @brief Parse the command line arguments into the given Options object.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @param options Options object to write the parsed options.
+ *
+ * @return true if the arguments are valid; false otherwise.
+ */
+static bool parse_options(int argc, char** argv, Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg{argv[i]};
+        if (arg == "--precision" && i + 1 < argc) {
+            long precision;
+            const std::string value{argv[++i]};
+            const char* end = value.data() + value.size();
+            if (parse_int(value.data(), end, precision) != end ||
+                precision < 0 || precision > max_fixed_precision) {
+                return false;
+            }
+            options.precision = static_cast<int>(precision);
+        } else if (arg == "--shortest") {
+            options.precision = CsvWriter::shortest;
+        } else if (arg == "--format" && i + 1 < argc) {
+            options.format = argv[++i];
+            if (options.format != "csv" && options.format != "npy" &&
+                options.format != "columnar") {
+                return false;
+            }
+        } else if (arg == "--batch") {
+            options.batch = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            long jobs;
+            const std::string value{argv[++i]};
+            const char* end = value.data() + value.size();
+            if (parse_int(value.data(), end, jobs) != end || jobs <= 0) {
+                return false;
+            }
+            options.jobs = static_cast<size_t>(jobs);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            long threads;
+            const std::string value{argv[++i]};
+            const char* end = value.data() + value.size();
+            if (parse_int(value.data(), end, threads) != end || threads <= 0) {
+                return false;
+            }
+            options.threads = static_cast<size_t>(threads);
+        } else if (arg == "--warm-start") {
+            options.warm_start = true;
+        } else if (arg == "--track-hulls") {
+            options.track_hulls = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            long seed;
+            const std::string value{argv[++i]};
+            const char* end = value.data() + value.size();
+            if (parse_int(value.data(), end, seed) != end || seed < 0) {
+                return false;
+            }
+            options.seed = static_cast<uint64_t>(seed);
+        } else if (arg == "--kmeans-restarts" && i + 1 < argc) {
+            long n_init;
+            const std::string value{argv[++i]};
+            const char* end = value.data() + value.size();
+            if (parse_int(value.data(), end, n_init) != end || n_init <= 0 ||
+                n_init > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            options.restarts.n_init = static_cast<int>(n_init);
+        } else if (arg == "--kmeans-patience" && i + 1 < argc) {
+            long patience;
+            const std::string value{argv[++i]};
+            const char* end = value.data() + value.size();
+            if (parse_int(value.data(), end, patience) != end || patience < 0 ||
+                patience > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            options.restarts.patience = static_cast<int>(patience);
+        } else if (arg == "--malformed" && i + 1 < argc) {
+            const std::string policy{argv[++i]};
+            if (policy == "abort") {
+                options.on_malformed = MalformedPolicy::abort;
+            } else if (policy == "skip") {
+                options.on_malformed = MalformedPolicy::skip;
+            } else if (policy == "count") {
+                options.on_malformed = MalformedPolicy::count;
+            } else {
+                return false;
+            }
+        } else if (arg.compare(0, 2, "--") == 0) {
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    // matches are already processed in parallel in batch mode
+    if (options.threads == 0) {
+        options.threads =
+            options.batch ? 1 : std::thread::hardware_concurrency();
+    }
+
+    // output directory and inputs
+    if (options.batch) {
+        if (positional.size() < 2) {
+            return false;
+        }
+        options.output_dir = positional[0];
+        options.inputs.assign(positional.begin() + 1, positional.end());
+        return true;
+    }
+
+    // raw data and feature data paths
+    if (positional.size() != 2) {
+        return false;
+    }
+    options.raw_filepath = positional[0];
+    options.feature_filepath = positional[1];
+    return true;
 }
 
 /**
  * @brief Main function.
  *
- * This function reads rawdata and output feature filepaths from command
- * line arguments, computes the features and writes them to output file by
- * calling features_from_raw function.
+ * This function reads rawdata and output feature filepaths and other options
+ * from command line arguments, computes the features and writes them to output file by
+ * calling features_from_raw function. In batch mode, the features of all the
+ * given matches are computed by calling batch_features_from_raw function.
  */
 int main(int argc, char** argv) {
     // set signal_setter to SIGINT signals.
     std::signal(SIGINT, signal_setter);
 
-    // Number of arguments must be 3, including program name.
-    if (argc != 3) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
         // print usage
         print_usage(std::cout, argv[0]);
         return -1;
     }
 
-    const std::string raw_filepath{argv[1]};
-    const std::string feature_filepath{argv[2]};
-    features_from_raw(raw_filepath, feature_filepath);
+    try {
+        if (options.batch) {
+            return batch_features_from_raw(options) ? 0 : -1;
+        }
+        const MatchSummary summary = features_from_raw(
+            options.raw_filepath, options.feature_filepath, options);
+        if (g_signal_status == SIGINT) {
+            std::cerr << "\nInterrupt: Exiting program" << std::endl;
+        }
+        if (summary.num_malformed != 0) {
+            std::cerr << summary.num_malformed << " malformed frames skipped"
+                      << std::endl;
+            if (options.on_malformed == MalformedPolicy::count) {
+                return -1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
 
     return 0;
 }
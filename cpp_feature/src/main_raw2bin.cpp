@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "raw_binary.hpp"
+
+/**
+ * @brief Print program usage and command line argument help to the given output
+ * stream.
+ *
+ * @param os Output stream to print info.
+ * @param program_name Name of the program to print in usage.
+ */
+static void print_usage(std::ostream& os, const std::string& program_name) {
+    os << "raw2bin" << std::endl;
+    os << "=======" << std::endl;
+    os << "Usage: " << program_name << " <rawdata_path> <out_binary_path>"
+       << std::endl
+       << std::endl;
+    os << "Converts the text raw data in <rawdata_path> to a binary raw\n"
+       << "file that can be given to feature instead of the text file."
+       << std::endl;
+    os << std::endl;
+    os << "Binary raw files are memory-mapped and read without any\n"
+       << "parsing. All 100 millisecond frames are kept." << std::endl;
+}
+
+/**
+ * @brief Main function.
+ *
+ * This function reads rawdata and output binary filepaths from command line
+ * arguments and converts the text raw data to binary raw data.
+ */
+int main(int argc, char** argv) {
+    // Number of arguments must be 3, including program name.
+    if (argc != 3) {
+        // print usage
+        print_usage(std::cout, argv[0]);
+        return -1;
+    }
+
+    const std::string raw_filepath{argv[1]};
+    const std::string binary_filepath{argv[2]};
+    try {
+        size_t num_frames = convert_raw_to_binary(raw_filepath, binary_filepath);
+        std::cout << "Converted " << num_frames << " frames" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
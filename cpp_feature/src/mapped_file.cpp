@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.hpp"
+
+MappedFile::MappedFile(const std::string& filepath)
+    : data(nullptr), length(0) {
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Cannot open file: " + filepath);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        throw std::runtime_error("Cannot stat file: " + filepath);
+    }
+    this->length = static_cast<size_t>(st.st_size);
+
+    // mmap doesn't accept zero length mappings; an empty file is an empty range
+    if (this->length != 0) {
+        void* addr = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map file: " + filepath);
+        }
+        // we read the file from beginning to end only once
+        madvise(addr, this->length, MADV_SEQUENTIAL);
+        this->data = static_cast<const char*>(addr);
+    }
+
+    // the mapping stays valid after the file descriptor is closed
+    close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(other.data), length(other.length) {
+    other.data = nullptr;
+    other.length = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        this->unmap();
+        this->data = other.data;
+        this->length = other.length;
+        other.data = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { this->unmap(); }
+
+const char* MappedFile::begin() const { return this->data; }
+
+const char* MappedFile::end() const { return this->data + this->length; }
+
+size_t MappedFile::size() const { return this->length; }
+
+void MappedFile::unmap() {
+    if (this->data != nullptr) {
+        munmap(const_cast<char*>(this->data), this->length);
+        this->data = nullptr;
+        this->length = 0;
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief MappedFile maps a whole file to memory in read-only mode.
+ *
+ * The file contents are accessible through the range [begin(), end()) for the
+ * lifetime of the MappedFile object. Pages are loaded by the operating system
+ * on demand; hence, mapping a file is cheap even if the file is large and
+ * no copies of the file contents are made.
+ *
+ * MappedFile objects can be moved but not copied.
+ */
+class MappedFile {
+  public:
+    /**
+     * @brief Map the file in the given filepath to memory.
+     *
+     * @param filepath Path to the file to map.
+     *
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& filepath);
+
+    /**
+     * @brief Move constructor.
+     *
+     * The moved-from object is left as an empty mapping.
+     */
+    MappedFile(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * The moved-from object is left as an empty mapping.
+     */
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Unmap the file.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Return a pointer to the first byte of the file.
+     *
+     * @return Pointer to the first byte. May be nullptr if the file is empty.
+     */
+    const char* begin() const;
+
+    /**
+     * @brief Return a pointer to one past the last byte of the file.
+     *
+     * @return Pointer to one past the last byte.
+     */
+    const char* end() const;
+
+    /**
+     * @brief Return the size of the file in bytes.
+     *
+     * @return Number of bytes in the file.
+     */
+    size_t size() const;
+
+  private:
+    /**
+     * @brief Unmap the currently mapped region, if any.
+     */
+    void unmap();
+
+  private:
+    /**
+     * @brief Beginning of the mapped region.
+     */
+    const char* data;
+    /**
+     * @brief Size of the mapped region in bytes.
+     */
+    size_t length;
+};
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PAIRWISE_X86 1
+#include <immintrin.h>
+#endif
+
+#include "pairwise_distance.hpp"
+
+double reduce_pairwise_lanes(const double* lanes) {
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+/**
+ * @brief Scalar reference kernel.
+ */
+static double pairwise_scalar(const double* x, const double* y, size_t n) {
+    double lanes[pairwise_lanes] = {0};
+    for (size_t i = 1; i < n; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            const double dx = x[i] - x[j];
+            const double dy = y[i] - y[j];
+            lanes[j % pairwise_lanes] += std::sqrt(dx * dx + dy * dy);
+        }
+    }
+    return reduce_pairwise_lanes(lanes);
+}
+
+/**
+ * @brief Scalar reference kernel of point_distances.
+ */
+static void point_scalar(double x, double y, const double* xs,
+                         const double* ys, size_t begin, size_t n,
+                         double* out) {
+    for (size_t j = begin; j < n; ++j) {
+        const double dx = x - xs[j];
+        const double dy = y - ys[j];
+        out[j] = std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+#ifdef PAIRWISE_X86
+
+/**
+ * @brief SSE2 kernel computing two distances per instruction.
+ */
+static double pairwise_sse2(const double* x, const double* y, size_t n) {
+    __m128d acc[4];
+    for (auto& a : acc) {
+        a = _mm_setzero_pd();
+    }
+    for (size_t i = 1; i < n; ++i) {
+        const __m128d xi = _mm_set1_pd(x[i]);
+        const __m128d yi = _mm_set1_pd(y[i]);
+        const __m128d iv = _mm_set1_pd(static_cast<double>(i));
+        for (size_t jb = 0; jb < i; jb += pairwise_lanes) {
+            // vectors past i add only zeros; hence, they are skipped
+            for (size_t q = 0; q < 4 && jb + 2 * q < i; ++q) {
+                const size_t j = jb + 2 * q;
+                const __m128d dx = _mm_sub_pd(xi, _mm_loadu_pd(x + j));
+                const __m128d dy = _mm_sub_pd(yi, _mm_loadu_pd(y + j));
+                const __m128d d = _mm_sqrt_pd(
+                    _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+                // only the pairs with j < i
+                const __m128d jv = _mm_set_pd(static_cast<double>(j + 1),
+                                              static_cast<double>(j));
+                acc[q] = _mm_add_pd(acc[q],
+                                    _mm_and_pd(_mm_cmplt_pd(jv, iv), d));
+            }
+        }
+    }
+    double lanes[pairwise_lanes];
+    for (size_t q = 0; q < 4; ++q) {
+        _mm_storeu_pd(lanes + 2 * q, acc[q]);
+    }
+    return reduce_pairwise_lanes(lanes);
+}
+
+/**
+ * @brief AVX2 kernel computing four distances per instruction.
+ */
+__attribute__((target("avx2"))) static double
+pairwise_avx2(const double* x, const double* y, size_t n) {
+    __m256d acc[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+    const __m256d offsets[2] = {_mm256_set_pd(3, 2, 1, 0),
+                                _mm256_set_pd(7, 6, 5, 4)};
+    for (size_t i = 1; i < n; ++i) {
+        const __m256d xi = _mm256_set1_pd(x[i]);
+        const __m256d yi = _mm256_set1_pd(y[i]);
+        const __m256d iv = _mm256_set1_pd(static_cast<double>(i));
+        for (size_t jb = 0; jb < i; jb += pairwise_lanes) {
+            const __m256d jb_v = _mm256_set1_pd(static_cast<double>(jb));
+            // vectors past i add only zeros; hence, they are skipped
+            for (size_t q = 0; q < 2 && jb + 4 * q < i; ++q) {
+                const size_t j = jb + 4 * q;
+                const __m256d dx = _mm256_sub_pd(xi, _mm256_loadu_pd(x + j));
+                const __m256d dy = _mm256_sub_pd(yi, _mm256_loadu_pd(y + j));
+                const __m256d d = _mm256_sqrt_pd(_mm256_add_pd(
+                    _mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+                // only the pairs with j < i
+                const __m256d jv = _mm256_add_pd(jb_v, offsets[q]);
+                const __m256d mask = _mm256_cmp_pd(jv, iv, _CMP_LT_OQ);
+                acc[q] = _mm256_add_pd(acc[q], _mm256_and_pd(mask, d));
+            }
+        }
+    }
+    double lanes[pairwise_lanes];
+    _mm256_storeu_pd(lanes, acc[0]);
+    _mm256_storeu_pd(lanes + 4, acc[1]);
+    return reduce_pairwise_lanes(lanes);
+}
+
+/**
+ * @brief AVX-512 kernel computing eight distances per instruction.
+ */
+__attribute__((target("avx512f"))) static double
+pairwise_avx512(const double* x, const double* y, size_t n) {
+    __m512d acc = _mm512_setzero_pd();
+    const __m512d offsets = _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0);
+    for (size_t i = 1; i < n; ++i) {
+        const __m512d xi = _mm512_set1_pd(x[i]);
+        const __m512d yi = _mm512_set1_pd(y[i]);
+        const __m512d iv = _mm512_set1_pd(static_cast<double>(i));
+        for (size_t jb = 0; jb < i; jb += pairwise_lanes) {
+            const __m512d dx = _mm512_sub_pd(xi, _mm512_loadu_pd(x + jb));
+            const __m512d dy = _mm512_sub_pd(yi, _mm512_loadu_pd(y + jb));
+            // only the pairs with j < i; the others are zeroed
+            const __m512d jv =
+                _mm512_add_pd(_mm512_set1_pd(static_cast<double>(jb)), offsets);
+            const __mmask8 mask = _mm512_cmp_pd_mask(jv, iv, _CMP_LT_OQ);
+            const __m512d d = _mm512_maskz_sqrt_pd(
+                mask,
+                _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+            acc = _mm512_add_pd(acc, d);
+        }
+    }
+    double lanes[pairwise_lanes];
+    _mm512_storeu_pd(lanes, acc);
+    return reduce_pairwise_lanes(lanes);
+}
+
+/**
+ * @brief SSE2 kernel of point_distances.
+ */
+static void point_sse2(double x, double y, const double* xs, const double* ys,
+                       size_t n, double* out) {
+    const __m128d xv = _mm_set1_pd(x);
+    const __m128d yv = _mm_set1_pd(y);
+    size_t j = 0;
+    for (; j + 2 <= n; j += 2) {
+        const __m128d dx = _mm_sub_pd(xv, _mm_loadu_pd(xs + j));
+        const __m128d dy = _mm_sub_pd(yv, _mm_loadu_pd(ys + j));
+        _mm_storeu_pd(out + j, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx),
+                                                      _mm_mul_pd(dy, dy))));
+    }
+    point_scalar(x, y, xs, ys, j, n, out);
+}
+
+/**
+ * @brief AVX2 kernel of point_distances.
+ */
+__attribute__((target("avx2"))) static void
+point_avx2(double x, double y, const double* xs, const double* ys, size_t n,
+           double* out) {
+    const __m256d xv = _mm256_set1_pd(x);
+    const __m256d yv = _mm256_set1_pd(y);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        const __m256d dx = _mm256_sub_pd(xv, _mm256_loadu_pd(xs + j));
+        const __m256d dy = _mm256_sub_pd(yv, _mm256_loadu_pd(ys + j));
+        _mm256_storeu_pd(out + j,
+                         _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx),
+                                                      _mm256_mul_pd(dy, dy))));
+    }
+    point_scalar(x, y, xs, ys, j, n, out);
+}
+
+#endif
+
+double pairwise_distance_sum(const double* x, const double* y, size_t n) {
+    return pairwise_distance_sum(x, y, n, simd_level());
+}
+
+double pairwise_distance_sum(const double* x, const double* y, size_t n,
+                             SimdLevel level) {
+    level = std::min(level, simd_level());
+    switch (level) {
+#ifdef PAIRWISE_X86
+    case SimdLevel::avx512:
+        return pairwise_avx512(x, y, n);
+    case SimdLevel::avx2:
+        return pairwise_avx2(x, y, n);
+    case SimdLevel::sse2:
+        return pairwise_sse2(x, y, n);
+#endif
+    default:
+        return pairwise_scalar(x, y, n);
+    }
+}
+
+void point_distances(double x, double y, const double* xs, const double* ys,
+                     size_t n, double* out) {
+    point_distances(x, y, xs, ys, n, out, simd_level());
+}
+
+void point_distances(double x, double y, const double* xs, const double* ys,
+                     size_t n, double* out, SimdLevel level) {
+    level = std::min(level, simd_level());
+    switch (level) {
+#ifdef PAIRWISE_X86
+    case SimdLevel::avx512:
+        // rows of a frame are too short for 8 lanes to pay off
+    case SimdLevel::avx2:
+        point_avx2(x, y, xs, ys, n, out);
+        return;
+    case SimdLevel::sse2:
+        point_sse2(x, y, xs, ys, n, out);
+        return;
+#endif
+    default:
+        point_scalar(x, y, xs, ys, 0, n, out);
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "simd.hpp"
+
+/**
+ * @brief Number of partial sums the pairwise distance kernels keep.
+ *
+ * Every kernel adds the distance of the pair (i, j) to the partial sum
+ * j % pairwise_lanes in the same order, and the partial sums are added in the
+ * same order at the end. Hence, all the kernels return exactly the same
+ * result on any CPU.
+ */
+constexpr size_t pairwise_lanes = 8;
+
+/**
+ * @brief Return the smallest multiple of pairwise_lanes that is not less than
+ * n.
+ *
+ * Coordinate arrays given to pairwise_distance_sum must have at least this
+ * many elements so that the kernels can read whole vectors; the values of the
+ * padding are ignored.
+ */
+constexpr size_t pairwise_padded_size(size_t n) {
+    return (n + pairwise_lanes - 1) / pairwise_lanes * pairwise_lanes;
+}
+
+/**
+ * @brief Add the pairwise_lanes partial sums in the order used by the
+ * pairwise distance kernels.
+ *
+ * A sum computed outside the kernels is bitwise equal to
+ * pairwise_distance_sum when the distance of pair (i, j), i > j, is added to
+ * lanes[j % pairwise_lanes] for i in ascending order and then the lanes are
+ * added using this function.
+ */
+double reduce_pairwise_lanes(const double* lanes);
+
+/**
+ * @brief Calculate the sum of the Euclidean distances between all pairs of the
+ * given points using the widest kernel supported by the CPU.
+ *
+ * Points are given in structure of arrays layout where point i is (x[i],
+ * y[i]). The sum is the same as adding dist(x[i], y[i], x[j], y[j]) for all
+ * i < j up to the rounding errors of the summation order.
+ *
+ * @param x x coordinates of the points. There must be at least
+ * pairwise_padded_size(n) elements.
+ * @param y y coordinates of the points. There must be at least
+ * pairwise_padded_size(n) elements.
+ * @param n Number of points.
+ *
+ * @return Sum of the distances of all pairs; 0 if there are less than two
+ * points.
+ */
+double pairwise_distance_sum(const double* x, const double* y, size_t n);
+
+/**
+ * @brief Same as the function above where the kernel of the given SimdLevel
+ * is used. If the CPU doesn't support the given level, the widest supported
+ * level is used.
+ */
+double pairwise_distance_sum(const double* x, const double* y, size_t n,
+                             SimdLevel level);
+
+/**
+ * @brief Calculate the Euclidean distances of point (x, y) to the given points
+ * using the widest kernel supported by the CPU.
+ *
+ * Distances are computed exactly as in dist(x, y, xs[j], ys[j]); hence, the
+ * results of all the kernels are the same. The arrays need no padding.
+ *
+ * @param x x coordinate of the point.
+ * @param y y coordinate of the point.
+ * @param xs x coordinates of the other points.
+ * @param ys y coordinates of the other points.
+ * @param n Number of the other points.
+ * @param out Output array of n elements where out[j] is the distance of
+ * (x, y) to (xs[j], ys[j]).
+ */
+void point_distances(double x, double y, const double* xs, const double* ys,
+                     size_t n, double* out);
+
+/**
+ * @brief Same as the function above where the kernel of the given SimdLevel
+ * is used. If the CPU doesn't support the given level, the widest supported
+ * level is used.
+ */
+void point_distances(double x, double y, const double* xs, const double* ys,
+                     size_t n, double* out, SimdLevel level);
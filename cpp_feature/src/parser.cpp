@@ -15,6 +15,9 @@
  */
 
 #include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
 #include <string>
 
 #include <feature/constants.hpp>
@@ -22,53 +25,285 @@
 #include <feature/row.hpp>
 #include <utils.hpp>
 
+#include "delimiter_index.hpp"
 #include "parser.hpp"
 
+/**
+ * @brief Parse an integer that spans the whole range [begin, end).
+ *
+ * @return true if the range is a single integer; false otherwise.
+ */
+static bool parse_int_field(const char* begin, const char* end, long& value) {
+    return begin != end && parse_int(begin, end, value) == end;
+}
+
+/**
+ * @brief Return whether the given value can be stored in an int.
+ */
+static bool fits_int(long value) {
+    return value >= std::numeric_limits<int>::min() &&
+           value <= std::numeric_limits<int>::max();
+}
+
+/**
+ * @brief Parse a double that spans the whole range [begin, end).
+ *
+ * @return true if the range is a single double; false otherwise.
+ */
+static bool parse_double_field(const char* begin, const char* end,
+                               double& value) {
+    return begin != end && parse_double(begin, end, value) == end;
+}
+
+/**
+ * @brief Split [begin, end) into exactly N fields separated by the given
+ * delimiter using the delimiter index of the line.
+ *
+ * @return nullptr if there are exactly N fields; otherwise, a pointer to the
+ * byte where the split fails.
+ */
+template <int N>
+static const char* split_fields(const DelimiterIndex& index, const char* begin,
+                                const char* end, unsigned delim,
+                                const char* (&field_begin)[N],
+                                const char* (&field_end)[N]) {
+    field_begin[0] = begin;
+    for (int i = 0; i < N - 1; ++i) {
+        field_end[i] = index.find(field_begin[i], end, delim);
+        if (field_end[i] == end) {
+            return end;
+        }
+        field_begin[i + 1] = field_end[i] + 1;
+    }
+    field_end[N - 1] = index.find(field_begin[N - 1], end, delim);
+    return field_end[N - 1] == end ? nullptr : field_end[N - 1];
+}
+
+/**
+ * @brief Parse a single player given as type,id,jersey,x,y and append it to
+ * the given sequence.
+ *
+ * @return Status of the player and the byte where the error is detected.
+ */
+static ParseStatus parse_player(const DelimiterIndex& index,
+                                const char* begin, const char* end,
+                                feature::player_seq& players,
+                                const char*& error) {
+    // separate with respect to comma
+    const char* field_begin[5];
+    const char* field_end[5];
+    error = split_fields(index, begin, end, delim_comma, field_begin,
+                         field_end);
+    if (error != nullptr) {
+        return ParseStatus::comma_split;
+    }
+
+    long ints[3];
+    for (int i = 0; i < 3; ++i) {
+        if (!parse_int_field(field_begin[i], field_end[i], ints[i]) ||
+            !fits_int(ints[i])) {
+            error = field_begin[i];
+            return ParseStatus::bad_integer;
+        }
+    }
+    double coords[2];
+    for (int i = 0; i < 2; ++i) {
+        if (!parse_double_field(field_begin[i + 3], field_end[i + 3],
+                                coords[i])) {
+            error = field_begin[i + 3];
+            return ParseStatus::bad_double;
+        }
+    }
+
+    // construct current player
+    players.emplace_back(static_cast<int>(ints[0]), static_cast<int>(ints[1]),
+                         static_cast<int>(ints[2]), coords[0], coords[1]);
+    return ParseStatus::ok;
+}
+
+const char* parse_status_message(ParseStatus status) {
+    switch (status) {
+    case ParseStatus::ok:
+        return "No error";
+    case ParseStatus::tab_split:
+        return "Tab split doesn't produce 6 pieces";
+    case ParseStatus::comma_split:
+        return "Comma split doesn't produce 5 pieces";
+    case ParseStatus::bad_integer:
+        return "Cannot parse integer field";
+    case ParseStatus::bad_double:
+        return "Cannot parse floating point field";
+    }
+    return "Unknown error";
+}
+
 feature::Row parse_line(const std::string& line) {
+    feature::Row res;
+    parse_line(line.data(), line.data() + line.size(), res);
+    return res;
+}
+
+void parse_line(const char* begin, const char* end, feature::Row& res) {
+    const ParseResult result = parse_into(begin, end, res);
+    if (!result.ok()) {
+        throw std::runtime_error(std::string("Raw frame format error: ") +
+                                 parse_status_message(result.status) +
+                                 " at byte " + std::to_string(result.offset));
+    }
+}
+
+ParseResult parse_into(const std::string& line, feature::Row& res) {
+    return parse_into(line.data(), line.data() + line.size(), res);
+}
+
+ParseResult parse_into(const char* begin, const char* end, feature::Row& res) {
+    // find all the delimiters of the line in a single pass
+    DelimiterIndex index;
+    index.scan(begin, end);
+    return parse_into(index, begin, end, res);
+}
+
+/**
+ * @brief Parse a well-formed line by walking through its delimiters once with
+ * a DelimiterStream.
+ *
+ * Every delimiter is checked to be the one expected by the raw match data
+ * format; the line is not searched again for each field.
+ *
+ * @return true if the line is parsed; false if the line is not well-formed,
+ * in which case it must be parsed by splitting its fields to find the error.
+ */
+static bool parse_well_formed(const DelimiterIndex& index, const char* begin,
+                              const char* end, feature::Row& res) {
+    DelimiterStream delims(index, begin, end,
+                           delim_tab | delim_space | delim_comma);
+
+    // tab separated header fields; timestamp is the only one that is not
+    // stored in an int
+    const char* field = begin;
+    long header[5];
+    for (int i = 0; i < 5; ++i) {
+        const char* tab = delims.next();
+        if (tab == end || *tab != '\t' ||
+            !parse_int_field(field, tab, header[i]) ||
+            (i != 1 && !fits_int(header[i]))) {
+            return false;
+        }
+        field = tab + 1;
+    }
+    res.match_id = static_cast<int>(header[0]);
+    res.timestamp = header[1];
+    res.half = static_cast<int>(header[2]);
+    res.minute = static_cast<int>(header[3]);
+    res.second = static_cast<int>(header[4]);
+    res.players.clear();
+
+    // get rid of end of the line whitespaces
+    const char* player_end = end;
+    while (player_end != field &&
+           std::isspace(static_cast<unsigned char>(player_end[-1]))) {
+        --player_end;
+    }
+
+    // players are separated by a space and their fields by commas
+    while (field != player_end) {
+        long ints[3];
+        double coords[2];
+        for (int i = 0; i < 5; ++i) {
+            const char* delim = delims.next();
+            if (i < 4 && (delim >= player_end || *delim != ',')) {
+                return false;
+            }
+            if (i == 4) {
+                // only whitespace can follow the last player, and a tab
+                // anywhere after the header is a malformed line
+                if (delim != end && (*delim == '\t' ||
+                                     (delim < player_end && *delim != ' '))) {
+                    return false;
+                }
+                delim = std::min(delim, player_end);
+            }
+            const bool parsed =
+                (i < 3) ? parse_int_field(field, delim, ints[i]) &&
+                              fits_int(ints[i])
+                        : parse_double_field(field, delim, coords[i - 3]);
+            if (!parsed) {
+                return false;
+            }
+            field = (delim == player_end) ? player_end : delim + 1;
+        }
+        res.players.emplace_back(
+            static_cast<int>(ints[0]), static_cast<int>(ints[1]),
+            static_cast<int>(ints[2]), coords[0], coords[1]);
+    }
+    for (const char* delim = delims.next(); delim != end;
+         delim = delims.next()) {
+        if (*delim == '\t') {
+            return false;
+        }
+    }
+
+    // players of each type follow each other
+    feature::group_by_type(res.players);
+    return true;
+}
+
+ParseResult parse_into(const DelimiterIndex& index, const char* begin,
+                       const char* end, feature::Row& res) {
+    if (parse_well_formed(index, begin, end, res)) {
+        return ParseResult{ParseStatus::ok, 0};
+    }
+
+    // split the fields of the malformed line to find the error
+    auto failure = [begin](ParseStatus status, const char* pos) {
+        return ParseResult{status, static_cast<size_t>(pos - begin)};
+    };
+
     // separate row with respect to tab
-    std::vector<std::string> tab_separated = str_split(line, '\t');
-    if (tab_separated.size() != 6) {
-        throw std::runtime_error(
-            "Raw frame format error: Tab split doesn't produce 6 pieces");
+    const char* field_begin[6];
+    const char* field_end[6];
+    const char* error =
+        split_fields(index, begin, end, delim_tab, field_begin, field_end);
+    if (error != nullptr) {
+        return failure(ParseStatus::tab_split, error);
     }
 
     // Construct a Row object from tab separated values
-    feature::Row res;
-    res.match_id = stoi(tab_separated[0]);
-    res.timestamp = stol(tab_separated[1]);
-    res.half = stoi(tab_separated[2]);
-    res.minute = stoi(tab_separated[3]);
-    res.second = stoi(tab_separated[4]);
+    // timestamp is the only header field that is not stored in an int
+    long header[5];
+    for (int i = 0; i < 5; ++i) {
+        if (!parse_int_field(field_begin[i], field_end[i], header[i]) ||
+            (i != 1 && !fits_int(header[i]))) {
+            return failure(ParseStatus::bad_integer, field_begin[i]);
+        }
+    }
+    res.match_id = static_cast<int>(header[0]);
+    res.timestamp = header[1];
+    res.half = static_cast<int>(header[2]);
+    res.minute = static_cast<int>(header[3]);
+    res.second = static_cast<int>(header[4]);
+    res.players.clear();
 
     // get rid of end of the line whitespaces
-    rtrim(tab_separated.back());
-    if (tab_separated.back().empty()) {
-        return res;
+    const char* player_begin = field_begin[5];
+    const char* player_end = field_end[5];
+    while (player_end != player_begin &&
+           std::isspace(static_cast<unsigned char>(player_end[-1]))) {
+        --player_end;
     }
 
     // separate with respect to space to get player data
-    std::vector<std::string> space_separated =
-        str_split(tab_separated.back(), ' ');
-
-    // Construct a Player object from each split of space_separated.
-    feature::player_seq players(space_separated.size());
-    for (size_t i = 0; i < space_separated.size(); ++i) {
-        // separate with respect to comma
-        std::vector<std::string> comma_separated =
-            str_split(space_separated[i], ',');
-        if (comma_separated.size() != 5) {
-            throw std::runtime_error(
-                "Raw frame format error: Comma split doesn't produce 5 pieces");
+    while (player_begin != player_end) {
+        const char* space = index.find(player_begin, player_end, delim_space);
+        const ParseStatus status =
+            parse_player(index, player_begin, space, res.players, error);
+        if (status != ParseStatus::ok) {
+            return failure(status, error);
         }
-
-        // construct current player
-        players[i].type = stoi(comma_separated[0]);
-        players[i].id = stoi(comma_separated[1]);
-        players[i].jersey = stoi(comma_separated[2]);
-        players[i].x = stod(comma_separated[3]);
-        players[i].y = stod(comma_separated[4]);
+        player_begin = (space == player_end) ? player_end : space + 1;
     }
-    res.players = players;
 
-    return res;
+    // players of each type follow each other
+    feature::group_by_type(res.players);
+    return ParseResult{ParseStatus::ok, 0};
 }
@@ -16,14 +16,54 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include <feature/row.hpp>
 
+class DelimiterIndex;
+
+/**
+ * @brief Reason why a raw match data line could not be parsed.
+ *
+ * tab_split and comma_split mean that the line or a player doesn't have the
+ * expected number of fields; bad_integer and bad_double mean that a field
+ * cannot be parsed as a number. bad_integer is also returned for integers
+ * that don't fit in the int fields of feature::Row and feature::Player.
+ */
+enum class ParseStatus { ok, tab_split, comma_split, bad_integer, bad_double };
+
+/**
+ * @brief Result of parse_into.
+ */
+struct ParseResult {
+    /**
+     * @brief Whether the line is parsed, or why it is malformed.
+     */
+    ParseStatus status;
+    /**
+     * @brief Offset of the byte where the error is detected from the
+     * beginning of the line. 0 if the line is parsed successfully.
+     */
+    size_t offset;
+
+    /**
+     * @brief Return whether the line is parsed successfully.
+     */
+    bool ok() const { return this->status == ParseStatus::ok; }
+};
+
+/**
+ * @brief Return a human readable description of the given status.
+ */
+const char* parse_status_message(ParseStatus status);
+
 /**
  * @brief Parse a line from raw match data and return it as a Row object.
  *
  * Refer to the format of raw match data in feature_construction.ipynb notebook.
+ * Players of the returned Row are grouped by their types using
+ * feature::group_by_type.
  *
  * @param line A single line of the raw match data to be parsed.
  *
@@ -31,3 +71,68 @@
  * line.
  */
 feature::Row parse_line(const std::string& line);
+
+/**
+ * @brief Parse a line from raw match data given as the character range [begin,
+ * end) and write it to the given Row object.
+ *
+ * This function parses the line in-place without creating any intermediate
+ * strings. Previous contents of res are overwritten; however, the memory
+ * already allocated for res.players is reused. Hence, parsing many lines into
+ * the same Row object doesn't allocate any memory in the steady state.
+ *
+ * The range must not contain the newline character at the end of the line.
+ *
+ * @param begin Beginning of the line.
+ * @param end End of the line (one past the last character).
+ * @param res Row object to write the parsed line.
+ *
+ * @throws std::runtime_error if the line is not in the raw match data format.
+ */
+void parse_line(const char* begin, const char* end, feature::Row& res);
+
+/**
+ * @brief Parse a line from raw match data given as the character range [begin,
+ * end) and write it to the given Row object, reporting malformed lines with a
+ * status instead of an exception.
+ *
+ * This function works the same as parse_line(const char*, const char*,
+ * feature::Row&); memory already allocated for res.players is reused. Instead
+ * of throwing, malformed lines are reported with a status and the offset of
+ * the offending byte so that callers can skip them cheaply. If the line is
+ * malformed, the contents of res are unspecified.
+ *
+ * @param begin Beginning of the line.
+ * @param end End of the line (one past the last character).
+ * @param res Row object to write the parsed line.
+ *
+ * @return ParseResult with ParseStatus::ok if the line is parsed; otherwise,
+ * the reason and the byte offset of the error.
+ */
+ParseResult parse_into(const char* begin, const char* end,
+                       feature::Row& res);
+
+/**
+ * @brief Parse the given line from raw match data into the given Row object,
+ * reporting malformed lines with a status instead of an exception.
+ *
+ * @see parse_into(const char*, const char*, feature::Row&)
+ */
+ParseResult parse_into(const std::string& line, feature::Row& res);
+
+/**
+ * @brief Same as parse_into(const char*, const char*, feature::Row&) where the
+ * fields of the line are found using the given DelimiterIndex instead of
+ * searching the characters of the line.
+ *
+ * The index is built once for many lines; e.g. RawReader indexes the raw match
+ * data file in large windows and parses each line of a window with this
+ * function.
+ *
+ * @param index DelimiterIndex whose indexed range contains [begin, end).
+ * @param begin Beginning of the line.
+ * @param end End of the line (one past the last character).
+ * @param res Row object to write the parsed line.
+ */
+ParseResult parse_into(const DelimiterIndex& index, const char* begin,
+                       const char* end, feature::Row& res);
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "raw_binary.hpp"
+#include "raw_reader.hpp"
+
+static_assert(sizeof(BinaryRawHeader) == 32, "Unexpected header padding");
+static_assert(sizeof(BinaryRawFrame) == 32, "Unexpected frame padding");
+static_assert(sizeof(BinaryRawPlayer) == 32, "Unexpected player padding");
+
+/**
+ * @brief Index used to denote that next_second hasn't returned any frame.
+ */
+static constexpr size_t no_frame = std::numeric_limits<size_t>::max();
+
+bool is_raw_binary(const std::string& filepath) {
+    std::ifstream ifs(filepath, std::ifstream::binary);
+    char magic[sizeof(raw_binary_magic)];
+    if (!ifs.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, raw_binary_magic, sizeof(magic)) == 0;
+}
+
+size_t convert_raw_to_binary(const std::string& raw_filepath,
+                             const std::string& binary_filepath) {
+    RawReader reader(raw_filepath);
+
+    // collect all frames and players; counts must be known to write the header
+    std::vector<BinaryRawFrame> frames;
+    std::vector<BinaryRawPlayer> players;
+    feature::Row row;
+    while (reader.next(row)) {
+        if (players.size() + row.players.size() >
+            std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Too many players for binary raw format");
+        }
+
+        BinaryRawFrame frame;
+        frame.timestamp = row.timestamp;
+        frame.match_id = row.match_id;
+        frame.half = row.half;
+        frame.minute = row.minute;
+        frame.second = row.second;
+        frame.first_player = static_cast<uint32_t>(players.size());
+        frame.num_players = static_cast<uint32_t>(row.players.size());
+        frames.push_back(frame);
+
+        for (const auto& p : row.players) {
+            players.push_back({p.type, p.id, p.jersey, 0, p.x, p.y});
+        }
+    }
+
+    BinaryRawHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, raw_binary_magic, sizeof(header.magic));
+    header.version = raw_binary_version;
+    header.converted = reader.converted();
+    header.home_left = reader.home_left();
+    header.num_frames = frames.size();
+    header.num_players = players.size();
+
+    std::ofstream ofs(binary_filepath, std::ofstream::binary);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(frames.data()),
+              frames.size() * sizeof(BinaryRawFrame));
+    ofs.write(reinterpret_cast<const char*>(players.data()),
+              players.size() * sizeof(BinaryRawPlayer));
+    if (!ofs) {
+        throw std::runtime_error("Cannot write file: " + binary_filepath);
+    }
+
+    return frames.size();
+}
+
+BinaryRawReader::BinaryRawReader(const std::string& filepath)
+    : file(filepath), header(nullptr), frames(nullptr), players(nullptr),
+      cursor(0), prev_second_index(no_frame) {
+    const size_t size = this->file.size();
+    if (size < sizeof(BinaryRawHeader)) {
+        throw std::runtime_error("Not a binary raw file: " + filepath);
+    }
+
+    // mmap returns page aligned memory; all sections are 8 byte aligned.
+    this->header = reinterpret_cast<const BinaryRawHeader*>(this->file.begin());
+    if (std::memcmp(this->header->magic, raw_binary_magic,
+                    sizeof(raw_binary_magic)) != 0) {
+        throw std::runtime_error("Not a binary raw file: " + filepath);
+    }
+    if (this->header->version != raw_binary_version) {
+        throw std::runtime_error("Unsupported binary raw file version: " +
+                                 filepath);
+    }
+
+    // sections must exactly fill the file
+    const uint64_t num_frames = this->header->num_frames;
+    const uint64_t num_players = this->header->num_players;
+    const uint64_t max_records = size / sizeof(BinaryRawFrame);
+    if (num_frames > max_records || num_players > max_records ||
+        sizeof(BinaryRawHeader) + num_frames * sizeof(BinaryRawFrame) +
+                num_players * sizeof(BinaryRawPlayer) !=
+            size) {
+        throw std::runtime_error("Corrupted binary raw file: " + filepath);
+    }
+
+    this->frames = reinterpret_cast<const BinaryRawFrame*>(
+        this->file.begin() + sizeof(BinaryRawHeader));
+    this->players =
+        reinterpret_cast<const BinaryRawPlayer*>(this->frames + num_frames);
+
+    // player ranges of frames must lie in the players section
+    for (uint64_t i = 0; i < num_frames; ++i) {
+        const auto& f = this->frames[i];
+        if (uint64_t(f.first_player) + f.num_players > num_players) {
+            throw std::runtime_error("Corrupted binary raw file: " + filepath);
+        }
+    }
+}
+
+size_t BinaryRawReader::size() const { return this->header->num_frames; }
+
+void BinaryRawReader::frame(size_t index, feature::Row& row) const {
+    const BinaryRawFrame& f = this->frames[index];
+    row.match_id = f.match_id;
+    row.timestamp = f.timestamp;
+    row.half = f.half;
+    row.minute = f.minute;
+    row.second = f.second;
+
+    row.players.clear();
+    const BinaryRawPlayer* begin = this->players + f.first_player;
+    const BinaryRawPlayer* end = begin + f.num_players;
+    for (auto it = begin; it != end; ++it) {
+        row.players.emplace_back(it->type, it->id, it->jersey, it->x, it->y);
+    }
+    // files written from parsed rows are already grouped
+    feature::group_by_type(row.players);
+}
+
+bool BinaryRawReader::next(feature::Row& row) {
+    if (this->cursor == this->size()) {
+        return false;
+    }
+    this->frame(this->cursor++, row);
+    return true;
+}
+
+bool BinaryRawReader::next_second(feature::Row& row) {
+    for (; this->cursor != this->size(); ++this->cursor) {
+        // skip the frame if it belongs to the previous second
+        if (this->prev_second_index != no_frame) {
+            const auto& prev = this->frames[this->prev_second_index];
+            const auto& curr = this->frames[this->cursor];
+            if (curr.half == prev.half && curr.minute == prev.minute &&
+                curr.second == prev.second) {
+                continue;
+            }
+        }
+
+        this->prev_second_index = this->cursor;
+        this->frame(this->cursor++, row);
+        return true;
+    }
+    return false;
+}
+
+bool BinaryRawReader::converted() const { return this->header->converted; }
+
+bool BinaryRawReader::home_left() const { return this->header->home_left; }
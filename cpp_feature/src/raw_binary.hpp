@@ -0,0 +1,267 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <feature/row.hpp>
+
+#include "mapped_file.hpp"
+
+/**
+ * @brief Header of a binary raw match data file.
+ *
+ * A binary raw match data file stores the same information as a text raw match
+ * data file in a fixed layout that can be memory-mapped and used without any
+ * parsing. The file consists of three consecutive sections:
+ *
+ * Section | Contents
+ * ------- | --------
+ * header  | A single BinaryRawHeader
+ * frames  | num_frames many BinaryRawFrame objects, one for each line
+ * players | num_players many BinaryRawPlayer objects
+ *
+ * Players of a frame are stored consecutively in the players section starting
+ * at index first_player of the frame. All integers are stored in the native
+ * byte order of the machine that wrote the file.
+ */
+struct BinaryRawHeader {
+    /**
+     * @brief File signature; must be equal to raw_binary_magic.
+     */
+    char magic[8];
+    /**
+     * @brief Version of the file format; must be equal to
+     * raw_binary_version.
+     */
+    uint32_t version;
+    /**
+     * @brief Value of <is_converted> in the text raw match data.
+     */
+    uint8_t converted;
+    /**
+     * @brief Value of <home_left> in the text raw match data.
+     */
+    uint8_t home_left;
+    /**
+     * @brief Unused.
+     */
+    uint8_t padding[2];
+    /**
+     * @brief Number of frames (lines) in the file.
+     */
+    uint64_t num_frames;
+    /**
+     * @brief Total number of players in all the frames.
+     */
+    uint64_t num_players;
+};
+
+/**
+ * @brief A single frame (line) of the binary raw match data.
+ */
+struct BinaryRawFrame {
+    /**
+     * @brief Timestamp of the frame.
+     */
+    int64_t timestamp;
+    /**
+     * @brief ID of the match.
+     */
+    int32_t match_id;
+    /**
+     * @brief Half of the frame.
+     */
+    int32_t half;
+    /**
+     * @brief Minute of the frame.
+     */
+    int32_t minute;
+    /**
+     * @brief Second of the frame.
+     */
+    int32_t second;
+    /**
+     * @brief Index of the first player of this frame in the players section.
+     */
+    uint32_t first_player;
+    /**
+     * @brief Number of players in this frame.
+     */
+    uint32_t num_players;
+};
+
+/**
+ * @brief A single player record of the binary raw match data.
+ */
+struct BinaryRawPlayer {
+    /**
+     * @brief Type of the player (home/away/home-gk/away-gk/referee).
+     */
+    int32_t type;
+    /**
+     * @brief ID of the player.
+     */
+    int32_t id;
+    /**
+     * @brief Jersey number of the player.
+     */
+    int32_t jersey;
+    /**
+     * @brief Unused.
+     */
+    int32_t padding;
+    /**
+     * @brief x coordinate of the player in the pitch.
+     */
+    double x;
+    /**
+     * @brief y coordinate of the player in the pitch.
+     */
+    double y;
+};
+
+/**
+ * @brief Signature at the beginning of every binary raw match data file.
+ */
+constexpr char raw_binary_magic[8] = {'S', 'I', 'U', 'R', 'A', 'W', 'B', '\0'};
+
+/**
+ * @brief Current version of the binary raw match data format.
+ */
+constexpr uint32_t raw_binary_version = 1;
+
+/**
+ * @brief Check whether the file in the given filepath starts with the binary
+ * raw match data signature.
+ *
+ * @param filepath Path to the file to check.
+ *
+ * @return true if the file is a binary raw match data file; false otherwise.
+ */
+bool is_raw_binary(const std::string& filepath);
+
+/**
+ * @brief Convert a text raw match data file to a binary raw match data file.
+ *
+ * All the lines of the text file are converted; no sub-second lines are
+ * discarded.
+ *
+ * @param raw_filepath Path to the text raw match data file.
+ * @param binary_filepath Path to the binary raw match data file to write.
+ *
+ * @return Number of frames written.
+ *
+ * @throws std::runtime_error if the text file is malformed or the binary file
+ * cannot be written.
+ */
+size_t convert_raw_to_binary(const std::string& raw_filepath,
+                             const std::string& binary_filepath);
+
+/**
+ * @brief BinaryRawReader reads binary raw match data files.
+ *
+ * The file is memory-mapped; frames can be read sequentially using next and
+ * next_second, just like RawReader, or randomly using frame.
+ */
+class BinaryRawReader {
+  public:
+    /**
+     * @brief Map the binary raw match data file in the given filepath and
+     * validate its layout.
+     *
+     * @param filepath Path to the binary raw match data file.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid
+     * binary raw match data file.
+     */
+    explicit BinaryRawReader(const std::string& filepath);
+
+    /**
+     * @brief Return the number of frames in the file.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Write the frame at the given index to the given Row.
+     *
+     * @param index Index of the frame. Must be less than size().
+     * @param row Row object to write the frame. Memory allocated by the row is
+     * reused.
+     */
+    void frame(size_t index, feature::Row& row) const;
+
+    /**
+     * @brief Write the next frame to the given Row.
+     *
+     * @param row Row object to write the frame.
+     *
+     * @return true if a frame is read; false if there are no more frames.
+     */
+    bool next(feature::Row& row);
+
+    /**
+     * @brief Write the next frame whose (half, minute, second) triple differs
+     * from the frame returned by the previous call to this function.
+     *
+     * Frames of the same second are skipped without reading their players.
+     *
+     * @param row Row object to write the frame.
+     *
+     * @return true if a frame is read; false if there are no more frames.
+     */
+    bool next_second(feature::Row& row);
+
+    /**
+     * @brief Return whether the x coordinates are already converted so that
+     * home team is always on the left.
+     */
+    bool converted() const;
+
+    /**
+     * @brief Return whether the home team starts the match on the left half.
+     */
+    bool home_left() const;
+
+  private:
+    /**
+     * @brief Memory-mapped binary raw match data file.
+     */
+    MappedFile file;
+    /**
+     * @brief Header of the file.
+     */
+    const BinaryRawHeader* header;
+    /**
+     * @brief Beginning of the frames section.
+     */
+    const BinaryRawFrame* frames;
+    /**
+     * @brief Beginning of the players section.
+     */
+    const BinaryRawPlayer* players;
+    /**
+     * @brief Index of the next frame to read sequentially.
+     */
+    size_t cursor;
+    /**
+     * @brief Index of the frame returned by the previous call to next_second.
+     */
+    size_t prev_second_index;
+};
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+#include <utils.hpp>
+
+#include "parser.hpp"
+#include "raw_reader.hpp"
+
+/**
+ * @brief Skip whitespace and parse a 0/1 flag from [begin, end) in the same way
+ * as reading a bool using std::istream.
+ *
+ * @return Pointer to the first character after the flag.
+ *
+ * @throws std::runtime_error if there is no flag.
+ */
+static const char* parse_flag(const char* begin, const char* end, bool& flag) {
+    while (begin != end && std::isspace(static_cast<unsigned char>(*begin))) {
+        ++begin;
+    }
+    long value;
+    const char* flag_end = parse_int(begin, end, value);
+    if (flag_end == begin || (value != 0 && value != 1)) {
+        throw std::runtime_error(
+            "Raw file format error: Header must contain two 0/1 flags");
+    }
+    flag = value == 1;
+    return flag_end;
+}
+
+/**
+ * @brief Read only the half, minute and second fields of the raw match data
+ * line in [begin, end) whose tabs are found in the given DelimiterIndex.
+ *
+ * @return true if the fields could be read; false if the line is malformed.
+ */
+static bool read_hms(const DelimiterIndex& index, const char* begin,
+                     const char* end, long& half, long& minute, long& second) {
+    // skip match_id and timestamp
+    for (int i = 0; i < 2; ++i) {
+        const char* tab = index.find(begin, end, delim_tab);
+        if (tab == end) {
+            return false;
+        }
+        begin = tab + 1;
+    }
+
+    long* fields[3] = {&half, &minute, &second};
+    for (long* field : fields) {
+        const char* field_end = parse_int(begin, end, *field);
+        if (field_end == begin || field_end == end || *field_end != '\t') {
+            return false;
+        }
+        begin = field_end + 1;
+    }
+    return true;
+}
+
+RawReader::RawReader(const std::string& filepath, bool skip_malformed)
+    : file(filepath), cursor(nullptr), index(), window_end(nullptr),
+      line_number(1),
+      skip_malformed(skip_malformed), num_malformed(0), has_prev_second(false),
+      prev_half(-1), prev_minute(-1), prev_second(-1), converted_flag(false),
+      home_left_flag(false) {
+    const char* end = this->file.end();
+    const char* it = this->file.begin();
+
+    // read boolean values
+    it = parse_flag(it, end, this->converted_flag);
+    it = parse_flag(it, end, this->home_left_flag);
+
+    // skip the rest of the header line
+    this->cursor = it;
+    this->window_end = it;
+    this->advance(this->line_end());
+}
+
+void RawReader::advance(const char* newline) {
+    const char* end = this->file.end();
+    this->cursor = (newline == end) ? end : newline + 1;
+    ++this->line_number;
+}
+
+const char* RawReader::line_end() {
+    const char* end = this->file.end();
+    if (this->cursor == end) {
+        return end;
+    }
+    size_t window = index_window;
+    while (true) {
+        if (this->cursor < this->window_end) {
+            const char* newline =
+                this->index.find(this->cursor, this->window_end, delim_newline);
+            if (newline != this->window_end || this->window_end == end) {
+                return newline;
+            }
+        }
+
+        // index the next window starting at the line; it is grown until it
+        // contains the whole line
+        this->window_end =
+            this->cursor + std::min(window, static_cast<size_t>(
+                                                end - this->cursor));
+        this->index.scan(this->cursor, this->window_end);
+        window *= 2;
+    }
+}
+
+bool RawReader::parse(const char* newline, feature::Row& row) {
+    const char* line = this->cursor;
+    const size_t line_number = this->line_number;
+    const ParseResult result = parse_into(this->index, line, newline, row);
+    this->advance(newline);
+    if (result.ok()) {
+        return true;
+    }
+    if (this->skip_malformed) {
+        ++this->num_malformed;
+        return false;
+    }
+    const size_t offset = (line - this->file.begin()) + result.offset;
+    throw std::runtime_error("Raw frame format error at line " +
+                             std::to_string(line_number) + ", byte " +
+                             std::to_string(offset) + ": " +
+                             parse_status_message(result.status));
+}
+
+bool RawReader::next(feature::Row& row) {
+    const char* end = this->file.end();
+    while (this->cursor != end) {
+        if (this->parse(this->line_end(), row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RawReader::next_second(feature::Row& row) {
+    const char* end = this->file.end();
+    while (this->cursor != end) {
+        const char* newline = this->line_end();
+
+        // skip the line if it belongs to the previous second
+        long half, minute, second;
+        if (this->has_prev_second &&
+            read_hms(this->index, this->cursor, newline, half, minute,
+                     second) &&
+            half == this->prev_half && minute == this->prev_minute &&
+            second == this->prev_second) {
+            this->advance(newline);
+            continue;
+        }
+
+        // a malformed first line of a second gives its place to the next one
+        if (!this->parse(newline, row)) {
+            continue;
+        }
+
+        this->has_prev_second = true;
+        this->prev_half = row.half;
+        this->prev_minute = row.minute;
+        this->prev_second = row.second;
+        return true;
+    }
+    return false;
+}
+
+size_t RawReader::malformed() const { return this->num_malformed; }
+
+bool RawReader::converted() const { return this->converted_flag; }
+
+bool RawReader::home_left() const { return this->home_left_flag; }
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <feature/row.hpp>
+
+#include "delimiter_index.hpp"
+#include "mapped_file.hpp"
+
+/**
+ * @brief RawReader reads raw match data files line by line.
+ *
+ * The whole raw match data file is memory-mapped and each line is parsed
+ * in-place using parse_into; hence, no per-line or per-token strings are
+ * created. The delimiters of the file are found by scan_delimiters in windows
+ * of index_window bytes, and both the line ends and the fields of the lines are
+ * found in the DelimiterIndex of the current window. Hence, every byte of the
+ * file is classified once. Refer to the format of raw match data in feature_construction.ipynb
+ * notebook.
+ *
+ * Example:
+ * @code
+ *     RawReader reader("123_rawdata.txt");
+ *     feature::Row row;
+ *     while (reader.next(row)) {
+ *         // use row
+ *     }
+ * @endcode
+ */
+class RawReader {
+  public:
+    /**
+     * @brief Number of bytes indexed at once. A window starts at the beginning
+     * of a line and grows if a single line doesn't fit in it.
+     */
+    static constexpr size_t index_window = 1 << 16;
+
+    /**
+     * @brief Map the raw match data file in the given filepath and read its
+     * header.
+     *
+     * @param filepath Path to the raw match data file.
+     * @param skip_malformed If true, malformed lines are skipped and counted
+     * instead of throwing an exception.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or its header
+     * line is malformed.
+     */
+    explicit RawReader(const std::string& filepath,
+                       bool skip_malformed = false);
+
+    /**
+     * @brief Parse the next line of the raw match data into the given Row.
+     *
+     * @param row Row object to write the parsed line. Memory allocated by the
+     * row is reused.
+     *
+     * @return true if a line is parsed; false if there are no more lines.
+     *
+     * @throws std::runtime_error if the line is malformed and malformed lines
+     * are not skipped. The message contains the line number and the byte
+     * offset of the error in the file.
+     */
+    bool next(feature::Row& row);
+
+    /**
+     * @brief Parse the next line whose (half, minute, second) triple differs
+     * from the line returned by the previous call to this function.
+     *
+     * Raw match data contains a line for every 100 ms of the match. This
+     * function returns only the first line of each second. Only the tab
+     * separated header fields of the remaining lines of the same second are
+     * read; the lines are then skipped without parsing any player data.
+     *
+     * @param row Row object to write the parsed line. Memory allocated by the
+     * row is reused.
+     *
+     * @return true if a line is parsed; false if there are no more lines.
+     *
+     * @throws std::runtime_error if a line that is not skipped is malformed and
+     * malformed lines are not skipped.
+     */
+    bool next_second(feature::Row& row);
+
+    /**
+     * @brief Return the number of malformed lines skipped so far.
+     */
+    size_t malformed() const;
+
+    /**
+     * @brief Return whether the x coordinates in the raw data are already
+     * converted so that home team is always on the left.
+     */
+    bool converted() const;
+
+    /**
+     * @brief Return whether the home team starts the match on the left half.
+     */
+    bool home_left() const;
+
+  private:
+    /**
+     * @brief Parse the line in [this->cursor, newline) into the given Row and
+     * move the cursor to the next line.
+     *
+     * @return true if the line is parsed; false if it is malformed and
+     * skipped.
+     *
+     * @throws std::runtime_error if the line is malformed and malformed lines
+     * are not skipped.
+     */
+    bool parse(const char* newline, feature::Row& row);
+
+    /**
+     * @brief Move the cursor to the line after the given newline.
+     */
+    void advance(const char* newline);
+
+    /**
+     * @brief Return a pointer to the newline character ending the line at the
+     * cursor, or the end of the file if it is the last line without a newline.
+     *
+     * If the line doesn't end in the indexed window, a new window starting at
+     * the cursor is indexed.
+     */
+    const char* line_end();
+
+    /**
+     * @brief Memory-mapped raw match data file.
+     */
+    MappedFile file;
+    /**
+     * @brief Beginning of the next line to parse.
+     */
+    const char* cursor;
+    /**
+     * @brief Delimiters of the current window of the file.
+     */
+    DelimiterIndex index;
+    /**
+     * @brief End of the current window of the file. The window starts at or
+     * before the cursor if the cursor is before window_end.
+     */
+    const char* window_end;
+    /**
+     * @brief 1-based line number of the cursor in the file.
+     */
+    size_t line_number;
+    /**
+     * @brief Whether malformed lines are skipped instead of throwing.
+     */
+    bool skip_malformed;
+    /**
+     * @brief Number of malformed lines skipped so far.
+     */
+    size_t num_malformed;
+    /**
+     * @brief true if next_second has returned a line before.
+     */
+    bool has_prev_second;
+    /**
+     * @brief half of the line returned by the previous call to next_second.
+     */
+    long prev_half;
+    /**
+     * @brief minute of the line returned by the previous call to next_second.
+     */
+    long prev_minute;
+    /**
+     * @brief second of the line returned by the previous call to next_second.
+     */
+    long prev_second;
+    /**
+     * @brief Value of <is_converted> in the header of the file.
+     */
+    bool converted_flag;
+    /**
+     * @brief Value of <home_left> in the header of the file.
+     */
+    bool home_left_flag;
+};
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simd.hpp"
+
+/**
+ * @brief Query the widest SimdLevel supported by the CPU.
+ */
+static SimdLevel detect_simd_level() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::avx2;
+    }
+    return SimdLevel::sse2;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+SimdLevel simd_level() {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::scalar:
+        return "scalar";
+    case SimdLevel::sse2:
+        return "sse2";
+    case SimdLevel::avx2:
+        return "avx2";
+    case SimdLevel::avx512:
+        return "avx512";
+    }
+    return "unknown";
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/**
+ * @brief Instruction sets that the SIMD kernels are implemented with, from the
+ * narrowest to the widest.
+ *
+ * Kernels that have no implementation for a level use the widest narrower
+ * one.
+ */
+enum class SimdLevel : int { scalar, sse2, avx2, avx512 };
+
+/**
+ * @brief Return the widest SimdLevel supported by the CPU.
+ *
+ * The CPU is queried only once.
+ */
+SimdLevel simd_level();
+
+/**
+ * @brief Return the name of the given SimdLevel such as "avx2".
+ */
+const char* simd_level_name(SimdLevel level);
@@ -0,0 +1,279 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Sequence container that stores up to N elements inside the object
+ * and moves them to the heap only when it grows beyond N elements.
+ *
+ * Elements are contiguous and the iterators are plain pointers. Until the
+ * size exceeds N, constructing, copying and filling a SmallVector don't
+ * allocate any memory. Once the elements are moved to the heap, they stay
+ * there; as in std::vector, the capacity never shrinks.
+ *
+ * Only trivially copyable types are supported so that the elements can be
+ * copied and moved with std::memcpy.
+ *
+ * @tparam T Type of the elements.
+ * @tparam N Number of the elements stored inside the object.
+ */
+template <typename T, size_t N> class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SmallVector elements must be trivially copyable");
+    static_assert(N > 0, "SmallVector must have an inline capacity");
+
+  public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    /**
+     * @brief Number of the elements stored inside the object.
+     */
+    static constexpr size_t inline_capacity = N;
+
+  public:
+    SmallVector() : ptr(this->inline_data()), len(0), cap(N) {}
+
+    /**
+     * @brief Construct a SmallVector with n copies of the given value.
+     */
+    explicit SmallVector(size_t n, const T& value = T()) : SmallVector() {
+        this->resize(n, value);
+    }
+
+    SmallVector(std::initializer_list<T> init) : SmallVector() {
+        this->assign(init.begin(), init.end());
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        this->assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept : SmallVector() {
+        this->steal(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            this->steal(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> init) {
+        this->assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~SmallVector() { this->release(); }
+
+    /**
+     * @brief Replace the elements with the elements in [first, last), which
+     * must not be in this SmallVector.
+     */
+    void assign(const T* first, const T* last) {
+        const size_t n = static_cast<size_t>(last - first);
+        this->reserve(n);
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(this->ptr), first, n * sizeof(T));
+        }
+        this->len = n;
+    }
+
+    iterator begin() { return this->ptr; }
+    const_iterator begin() const { return this->ptr; }
+    const_iterator cbegin() const { return this->ptr; }
+    iterator end() { return this->ptr + this->len; }
+    const_iterator end() const { return this->ptr + this->len; }
+    const_iterator cend() const { return this->ptr + this->len; }
+
+    T* data() { return this->ptr; }
+    const T* data() const { return this->ptr; }
+
+    size_t size() const { return this->len; }
+    size_t capacity() const { return this->cap; }
+    bool empty() const { return this->len == 0; }
+
+    /**
+     * @brief Return true if the elements are stored inside the object.
+     */
+    bool is_inline() const { return this->ptr == this->inline_data(); }
+
+    T& operator[](size_t i) { return this->ptr[i]; }
+    const T& operator[](size_t i) const { return this->ptr[i]; }
+
+    T& at(size_t i) {
+        this->check_index(i);
+        return this->ptr[i];
+    }
+    const T& at(size_t i) const {
+        this->check_index(i);
+        return this->ptr[i];
+    }
+
+    T& front() { return this->ptr[0]; }
+    const T& front() const { return this->ptr[0]; }
+    T& back() { return this->ptr[this->len - 1]; }
+    const T& back() const { return this->ptr[this->len - 1]; }
+
+    /**
+     * @brief Make room for at least n elements, moving the elements to the
+     * heap if n is larger than the capacity.
+     */
+    void reserve(size_t n) {
+        if (n <= this->cap) {
+            return;
+        }
+        T* heap = static_cast<T*>(::operator new(n * sizeof(T)));
+        if (this->len != 0) {
+            std::memcpy(static_cast<void*>(heap), this->ptr,
+                        this->len * sizeof(T));
+        }
+        this->release();
+        this->ptr = heap;
+        this->cap = n;
+    }
+
+    void clear() { this->len = 0; }
+
+    void resize(size_t n) { this->resize(n, T()); }
+
+    void resize(size_t n, const T& value) {
+        if (n > this->len) {
+            const T copy = value;
+            this->reserve(std::max(n, this->grown_capacity()));
+            std::uninitialized_fill(this->ptr + this->len, this->ptr + n,
+                                    copy);
+        }
+        this->len = n;
+    }
+
+    void push_back(const T& value) {
+        const T copy = value;
+        this->emplace_back(copy);
+    }
+
+    template <typename... Args> T& emplace_back(Args&&... args) {
+        if (this->len == this->cap) {
+            this->reserve(this->grown_capacity());
+        }
+        T* elem = new (this->ptr + this->len) T(std::forward<Args>(args)...);
+        ++this->len;
+        return *elem;
+    }
+
+    void pop_back() { --this->len; }
+
+  private:
+    T* inline_data() { return reinterpret_cast<T*>(&this->storage); }
+    const T* inline_data() const {
+        return reinterpret_cast<const T*>(&this->storage);
+    }
+
+    /**
+     * @brief Capacity after growing by a factor of two.
+     */
+    size_t grown_capacity() const { return 2 * this->cap; }
+
+    /**
+     * @brief Free the heap memory if there is any. Elements are not changed.
+     */
+    void release() {
+        if (!this->is_inline()) {
+            ::operator delete(this->ptr);
+        }
+    }
+
+    /**
+     * @brief Take the elements of other, leaving it empty. Heap memory is
+     * moved without copying the elements.
+     */
+    void steal(SmallVector& other) {
+        if (other.is_inline()) {
+            this->assign(other.begin(), other.end());
+        } else {
+            this->release();
+            this->ptr = other.ptr;
+            this->cap = other.cap;
+            this->len = other.len;
+            other.ptr = other.inline_data();
+            other.cap = N;
+        }
+        other.len = 0;
+    }
+
+    void check_index(size_t i) const {
+        if (i >= this->len) {
+            throw std::out_of_range("SmallVector index out of range");
+        }
+    }
+
+  private:
+    /**
+     * @brief Inline storage of N elements.
+     */
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[N];
+    /**
+     * @brief Beginning of the elements; either storage or heap memory.
+     */
+    T* ptr;
+    /**
+     * @brief Number of the elements.
+     */
+    size_t len;
+    /**
+     * @brief Number of the elements that fit in the current memory.
+     */
+    size_t cap;
+};
+
+template <typename T, size_t N> constexpr size_t SmallVector<T, N>::inline_capacity;
+
+template <typename T, size_t N>
+bool operator==(const SmallVector<T, N>& v1, const SmallVector<T, N>& v2) {
+    return v1.size() == v2.size() &&
+           std::equal(v1.begin(), v1.end(), v2.begin());
+}
+
+template <typename T, size_t N>
+bool operator!=(const SmallVector<T, N>& v1, const SmallVector<T, N>& v2) {
+    return !(v1 == v2);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief ThreadPool runs submitted tasks on a fixed number of worker threads.
+ *
+ * Tasks are run in the order they are submitted. The destructor waits for all
+ * the submitted tasks to finish before joining the workers.
+ */
+class ThreadPool {
+  public:
+    /**
+     * @brief Start the given number of worker threads.
+     *
+     * @param num_threads Number of worker threads. If 0, the number of
+     * hardware threads is used.
+     */
+    explicit ThreadPool(size_t num_threads = 0);
+
+    /**
+     * @brief Wait for all the submitted tasks to finish and join the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Return the number of worker threads.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Submit a task to be run on one of the workers.
+     *
+     * Exceptions thrown by the task are stored in the returned future.
+     *
+     * @tparam Function A callable taking no arguments.
+     * @param func Task to run.
+     *
+     * @return Future holding the result of the task.
+     */
+    template <typename Function>
+    std::future<typename std::result_of<Function()>::type>
+    submit(Function&& func) {
+        using result_type = typename std::result_of<Function()>::type;
+        auto task = std::make_shared<std::packaged_task<result_type()>>(
+            std::forward<Function>(func));
+        std::future<result_type> res = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->tasks.emplace([task]() { (*task)(); });
+        }
+        this->task_available.notify_one();
+        return res;
+    }
+
+  private:
+    /**
+     * @brief Run tasks until the pool is stopped and no tasks remain.
+     */
+    void work();
+
+  private:
+    /**
+     * @brief Worker threads.
+     */
+    std::vector<std::thread> workers;
+    /**
+     * @brief Tasks waiting to be run.
+     */
+    std::queue<std::function<void()>> tasks;
+    /**
+     * @brief Mutex guarding tasks and stopping.
+     */
+    std::mutex mutex;
+    /**
+     * @brief Signalled when a task is submitted or the pool is stopped.
+     */
+    std::condition_variable task_available;
+    /**
+     * @brief Whether the pool is being destroyed.
+     */
+    bool stopping;
+};
@@ -14,8 +14,13 @@
  * limitations under the License.
  */
 
+#include <cctype>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <unordered_map>
 
 #include "utils.hpp"
@@ -58,10 +63,142 @@ void rtrim(std::string& s) {
             s.end());
 }
 
+const char* parse_int(const char* begin, const char* end, long& value) {
+    const char* it = begin;
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    // accumulate as a negative number so that LONG_MIN can be parsed, too
+    constexpr long min_value = std::numeric_limits<long>::min();
+    const char* digits_begin = it;
+    long accum = 0;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+        int digit = *it - '0';
+        if (accum < (min_value + digit) / 10) {
+            return begin; // overflow
+        }
+        accum = accum * 10 - digit;
+    }
+
+    if (it == digits_begin) {
+        return begin; // no digits
+    }
+    if (!negative) {
+        if (accum == min_value) {
+            return begin; // overflow
+        }
+        accum = -accum;
+    }
+    value = accum;
+    return it;
+}
+
+/**
+ * @brief Parse a double using std::strtod.
+ *
+ * Used by parse_double for the inputs that can't be converted exactly with
+ * integer arithmetic.
+ */
+static const char* parse_double_slow(const char* begin, const char* end,
+                                     double& value) {
+    // strtod requires a null terminated string
+    char buffer[64];
+    size_t len = std::min(static_cast<size_t>(end - begin), sizeof(buffer) - 1);
+    std::memcpy(buffer, begin, len);
+    buffer[len] = '\0';
+
+    // strtod skips leading whitespace; from_chars doesn't.
+    if (len == 0 || std::isspace(static_cast<unsigned char>(buffer[0]))) {
+        return begin;
+    }
+
+    char* parse_end;
+    double result = std::strtod(buffer, &parse_end);
+    if (parse_end == buffer) {
+        return begin;
+    }
+    value = result;
+    return begin + (parse_end - buffer);
+}
+
+const char* parse_double(const char* begin, const char* end, double& value) {
+    // powers of 10 that can be represented exactly as doubles
+    static constexpr double exact_pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int max_exact_pow10 = 22;
+    // integers up to 2^53 can be represented exactly as doubles
+    constexpr uint64_t max_exact_mantissa = uint64_t(1) << 53;
+
+    const char* it = begin;
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    // digits before and after the decimal point are accumulated in mantissa
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    bool too_many_digits = false;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+        too_many_digits |= mantissa > max_exact_mantissa;
+        mantissa = mantissa * 10 + (*it - '0');
+        ++num_digits;
+    }
+    if (it != end && *it == '.') {
+        ++it;
+        for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+            too_many_digits |= mantissa > max_exact_mantissa;
+            mantissa = mantissa * 10 + (*it - '0');
+            ++num_digits;
+            --exponent;
+        }
+    }
+
+    // inf, nan, hexadecimal numbers, ...
+    if (num_digits == 0) {
+        return parse_double_slow(begin, end, value);
+    }
+
+    if (it != end && (*it == 'e' || *it == 'E')) {
+        long exp_value;
+        const char* exp_end = parse_int(it + 1, end, exp_value);
+        if (exp_end != it + 1) {
+            if (exp_value > 1000 || exp_value < -1000) {
+                return parse_double_slow(begin, end, value);
+            }
+            exponent += static_cast<int>(exp_value);
+            it = exp_end;
+        }
+    }
+
+    // both the mantissa and the power of 10 are exact; hence, a single
+    // multiplication or division gives the correctly rounded result.
+    if (too_many_digits || mantissa > max_exact_mantissa ||
+        exponent > max_exact_pow10 || exponent < -max_exact_pow10) {
+        return parse_double_slow(begin, end, value);
+    }
+    double result = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        result /= exact_pow10[-exponent];
+    } else {
+        result *= exact_pow10[exponent];
+    }
+    value = negative ? -result : result;
+    return it;
+}
+
 bool close(double d1, double d2, double eps) { return fabs(d1 - d2) <= eps; }
 
 double dist(double x1, double y1, double x2, double y2) {
-    return std::sqrt(std::pow(x1 - x2, 2) + std::pow(y1 - y2, 2));
+    const double dx = x1 - x2;
+    const double dy = y1 - y2;
+    return std::sqrt(dx * dx + dy * dy);
 }
 
 double gini_impurity(const std::vector<int>& labels) {
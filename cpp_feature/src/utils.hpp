@@ -18,7 +18,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <iterator>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -63,6 +65,42 @@ std::vector<std::string> str_split(const std::string& str, const char delim);
  */
 void rtrim(std::string& s);
 
+/**
+ * @brief Parse an integer from the beginning of the character range [begin,
+ * end).
+ *
+ * This function works similar to std::from_chars. An optional sign followed by
+ * decimal digits are parsed; no whitespace is skipped and no memory is
+ * allocated.
+ *
+ * @param begin Beginning of the character range [begin, end).
+ * @param end End of the character range [begin, end).
+ * @param value Parsed integer is written to this variable on success.
+ *
+ * @return Pointer to the first character that is not part of the number. If
+ * no integer could be parsed or the integer doesn't fit in a long, begin is
+ * returned and value is not modified.
+ */
+const char* parse_int(const char* begin, const char* end, long& value);
+
+/**
+ * @brief Parse a double from the beginning of the character range [begin,
+ * end).
+ *
+ * This function works similar to std::from_chars. Numbers of the form
+ * [sign]digits[.digits][e[sign]digits] that can be represented exactly are
+ * converted without any library calls; the result is the correctly rounded
+ * double as returned by std::strtod. Other inputs are passed to std::strtod.
+ *
+ * @param begin Beginning of the character range [begin, end).
+ * @param end End of the character range [begin, end).
+ * @param value Parsed double is written to this variable on success.
+ *
+ * @return Pointer to the first character that is not part of the number. If
+ * no double could be parsed, begin is returned and value is not modified.
+ */
+const char* parse_double(const char* begin, const char* end, double& value);
+
 /**
  * @brief Check whether the difference between the given doubles is less than
  * or equal to epsilon value eps.
@@ -106,8 +144,10 @@ double dist(double x1, double y1, double x2, double y2);
 template <size_t N, typename Point>
 double dist(const Point& p1, const Point& p2) {
     double res = 0;
-    for (size_t i = 0; i < N; ++i)
-        res += std::pow(p1[i] - p2[i], 2);
+    for (size_t i = 0; i < N; ++i) {
+        const double delta = p1[i] - p2[i];
+        res += delta * delta;
+    }
 
     return std::sqrt(res);
 }
@@ -204,3 +244,61 @@ bool is_inv_map(const Map& mapping, const InverseMap& inv_mapping) {
     }
     return true;
 }
+
+/**
+ * @brief Allocator whose memory blocks start at multiples of the given
+ * alignment in bytes.
+ *
+ * Vectors using this allocator can be loaded with aligned SIMD instructions.
+ *
+ * @tparam T Type of the allocated objects.
+ * @tparam Alignment Alignment in bytes; a power of two multiple of
+ * sizeof(void*).
+ */
+template <typename T, size_t Alignment> class AlignedAllocator {
+  public:
+    typedef T value_type;
+
+    template <typename U> struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, Alignment, n * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t) { std::free(ptr); }
+};
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+    return false;
+}
+
+/**
+ * @brief Alignment of aligned_vector in bytes; a cache line, which is also
+ * the width of AVX-512 registers.
+ */
+constexpr size_t simd_alignment = 64;
+
+/**
+ * @brief Vector whose elements start at a multiple of simd_alignment.
+ */
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T, simd_alignment>>;
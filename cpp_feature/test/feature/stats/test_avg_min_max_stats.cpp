@@ -29,7 +29,7 @@ using namespace feature::details;
 
 TEST_CASE("Test avg_min_max_stats::avg_min_max_stats", "[avg_min_max_stats]") {
     SECTION("Check for multiple players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),   Player(78.91993306, 41.80005636),
             Player(65.03668249, 86.17347712), Player(62.24491594, 36.20383972),
             Player(74.52460286, 83.89700268), Player(34.86547034, 85.08598683),
@@ -79,9 +79,31 @@ TEST_CASE("Test avg_min_max_stats::avg_min_max_stats", "[avg_min_max_stats]") {
         }
     }
 
+    SECTION("Frame spans give the same results as Player ranges") {
+        player_seq players{Player(0, 1, 1, 10, 20),
+                           Player(0, 2, 2, 13, 21),
+                           Player(1, 3, 3, 50, 60),
+                           Player(1, 4, 4, 52.5, 67.25),
+                           Player(1, 5, 5, 41.3, 12.7)};
+        Frame frame;
+        frame.assign(players.cbegin(), players.cend());
+        std::vector<double> expected(num_features(), -10);
+        std::vector<double> features(num_features(), -10);
+
+        avg_min_max_stats(players.cbegin(), players.cbegin() + 2, Team::home,
+                          expected);
+        avg_min_max_stats(players.cbegin() + 2, players.cend(), Team::away,
+                          expected);
+        avg_min_max_stats(frame, frame.span(PlayerType::home), Team::home,
+                          features);
+        avg_min_max_stats(frame, frame.span(PlayerType::away), Team::away,
+                          features);
+        REQUIRE(features == expected);
+    }
+
     SECTION("Check for a single player") {
         const std::string prefix = "home";
-        std::vector<Player> players{Player(123, 456)};
+        player_seq players{Player(123, 456)};
         std::vector<double> features(num_features(), -10);
         avg_min_max_stats(players.begin(), players.end(), prefix, features);
 
@@ -91,7 +113,7 @@ TEST_CASE("Test avg_min_max_stats::avg_min_max_stats", "[avg_min_max_stats]") {
 
     SECTION("Check for no players") {
         const std::string prefix = "away";
-        std::vector<Player> players;
+        player_seq players;
         std::vector<double> features(num_features(), -10);
         REQUIRE_NOTHROW(avg_min_max_stats(players.begin(), players.end(),
                                           prefix, features));
@@ -30,7 +30,7 @@ using namespace feature::details;
 TEST_CASE("Test cluster_stats::cluster_stats", "[cluster_stats]") {
 
     SECTION("Multiple players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),   Player(78.91993306, 41.80005636),
             Player(65.03668249, 86.17347712), Player(62.24491594, 36.20383972),
             Player(74.52460286, 83.89700268), Player(34.86547034, 85.08598683),
@@ -70,7 +70,7 @@ TEST_CASE("Test cluster_stats::cluster_stats", "[cluster_stats]") {
     }
 
     SECTION("Two players") {
-        std::vector<Player> players{Player(123, 456), Player(742, 456)};
+        player_seq players{Player(123, 456), Player(742, 456)};
         std::vector<double> features(num_features(), -10);
 
         std::vector<std::string> prefixes{"player", "home", "away"};
@@ -85,7 +85,7 @@ TEST_CASE("Test cluster_stats::cluster_stats", "[cluster_stats]") {
     }
 
     SECTION("Single player") {
-        std::vector<Player> players{Player(123, 456)};
+        player_seq players{Player(123, 456)};
         std::vector<double> features = default_features();
 
         std::vector<std::string> prefixes{"player", "home", "away"};
@@ -100,7 +100,7 @@ TEST_CASE("Test cluster_stats::cluster_stats", "[cluster_stats]") {
     }
 
     SECTION("No players : Stats shouldn't change") {
-        std::vector<Player> players;
+        player_seq players;
         std::vector<double> features = default_features();
 
         std::vector<std::string> prefixes{"player", "home", "away"};
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <feature/player.hpp>
+#include <feature/stats/convex_hull.hpp>
+
+using namespace feature;
+using namespace feature::details;
+
+TEST_CASE("Test convex_hull::convex_hull", "[convex_hull]") {
+
+    SECTION("Square with inner and collinear points") {
+        player_seq players{Player(1, 1), Player(0, 0), Player(2, 0),
+                           Player(2, 2), Player(1, 0), Player(0, 2),
+                           Player(0, 1)};
+        // clockwise from the lexicographically smallest point
+        REQUIRE((convex_hull(players.begin(), players.end()) ==
+                 std::vector<int>{1, 5, 3, 2}));
+    }
+
+    SECTION("Players at the same position") {
+        player_seq players{Player(0, 0), Player(3, 0), Player(0, 0),
+                           Player(0, 3), Player(3, 0), Player(1, 1)};
+        // only the first player at each position is on the hull
+        REQUIRE((convex_hull(players.begin(), players.end()) ==
+                 std::vector<int>{0, 3, 1}));
+    }
+
+    SECTION("Collinear players") {
+        player_seq players{Player(1, 1), Player(2, 2), Player(0, 0),
+                           Player(3, 3)};
+        REQUIRE((convex_hull(players.begin(), players.end()) ==
+                 std::vector<int>{2, 3, 2}));
+    }
+
+    SECTION("All players at the same position") {
+        player_seq players{Player(5, 5), Player(5, 5), Player(5, 5)};
+        REQUIRE((convex_hull(players.begin(), players.end()) ==
+                 std::vector<int>{0, 0, 0}));
+    }
+
+    SECTION("Random players are inside the hull") {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> coord(0, 100);
+        player_seq players;
+        for (int i = 0; i < 25; ++i) {
+            players.emplace_back(coord(gen), coord(gen));
+        }
+        std::vector<int> order;
+        std::vector<int> hull;
+        convex_hull(players.begin(), players.end(), order, hull);
+        REQUIRE(hull.size() >= 3);
+
+        // every edge makes a clockwise turn with every player not on it
+        for (size_t e = 0; e < hull.size(); ++e) {
+            const Player& a = players[hull[e]];
+            const Player& b = players[hull[(e + 1) % hull.size()]];
+            for (const Player& p : players) {
+                REQUIRE(cross(a, b, p) <= 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test convex_hull::merge_hulls", "[convex_hull]") {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> coord(0, 6);
+    std::vector<int> order;
+    std::vector<int> vertices;
+
+    // small integer coordinates give many duplicate and collinear players
+    for (int trial = 0; trial < 500; ++trial) {
+        const int first_size = trial % 6;
+        const int second_size = (trial / 6) % 6;
+        if (first_size + second_size == 0) {
+            continue;
+        }
+        player_seq players;
+        for (int i = 0; i < first_size + second_size; ++i) {
+            players.emplace_back(coord(gen), coord(gen));
+        }
+        auto middle = players.cbegin() + first_size;
+
+        std::vector<int> first_hull;
+        std::vector<int> second_hull;
+        std::vector<int> merged;
+        convex_hull(players.cbegin(), middle, order, first_hull);
+        convex_hull(middle, players.cend(), order, second_hull);
+        merge_hulls(players.cbegin(), middle, first_hull, second_hull,
+                    vertices, order, merged);
+
+        REQUIRE(merged == convex_hull(players.cbegin(), players.cend()));
+    }
+}
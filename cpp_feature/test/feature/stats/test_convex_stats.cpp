@@ -30,7 +30,7 @@ using namespace feature::details;
 TEST_CASE("Test convex_stats::convex_stats", "[convex_stats]") {
 
     SECTION("Test multiple players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),   Player(78.91993306, 41.80005636),
             Player(65.03668249, 86.17347712), Player(62.24491594, 36.20383972),
             Player(74.52460286, 83.89700268), Player(34.86547034, 85.08598683),
@@ -120,7 +120,7 @@ TEST_CASE("Test convex_stats::convex_stats", "[convex_stats]") {
     }
 
     SECTION("Test 2 players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),
             Player(78.91993306, 41.80005636),
         };
@@ -151,7 +151,7 @@ TEST_CASE("Test convex_stats::convex_stats", "[convex_stats]") {
     }
 
     SECTION("Test a single player") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),
         };
         std::vector<double> speed{3.83741301};
@@ -181,7 +181,7 @@ TEST_CASE("Test convex_stats::convex_stats", "[convex_stats]") {
     }
 
     SECTION("Test no players") {
-        std::vector<Player> players;
+        player_seq players;
         std::vector<double> speed;
         std::vector<double> features(num_features(), -10);
 
@@ -208,3 +208,30 @@ TEST_CASE("Test convex_stats::convex_stats", "[convex_stats]") {
                 feature::default_value());
     }
 }
+
+TEST_CASE("Test convex_stats::convex_stats with merged hulls",
+          "[convex_stats]") {
+    player_seq players{
+        Player(10, 10), Player(20, 5),  Player(15, 30), Player(12, 12),
+        Player(40, 20), Player(35, 35), Player(20, 5),  Player(50, 10)};
+    std::vector<double> speed{1, 2, 3, 4, 5, 6, 7, 8};
+    auto middle = players.cbegin() + 4;
+
+    Workspace workspace;
+    std::vector<double> features(num_features(), default_value());
+    convex_stats(players.cbegin(), middle, speed.begin(), Team::home,
+                 workspace, features);
+    convex_stats(middle, players.cend(), speed.begin() + 4, Team::away,
+                 workspace, features);
+    convex_stats(players.cbegin(), middle, players.cend(), speed.begin(),
+                 workspace.hulls[static_cast<size_t>(Team::home)],
+                 workspace.hulls[static_cast<size_t>(Team::away)],
+                 Team::player, workspace, features);
+
+    std::vector<double> expected(num_features(), default_value());
+    convex_stats(players.cbegin(), middle, speed.begin(), "home", expected);
+    convex_stats(middle, players.cend(), speed.begin() + 4, "away", expected);
+    convex_stats(players.cbegin(), players.cend(), speed.begin(), "player",
+                 expected);
+    REQUIRE(features == expected);
+}
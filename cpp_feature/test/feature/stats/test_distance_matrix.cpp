@@ -0,0 +1,111 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <feature/frame.hpp>
+#include <feature/player.hpp>
+#include <feature/stats/distance_matrix.hpp>
+#include <pairwise_distance.hpp>
+#include <utils.hpp>
+
+using namespace feature;
+using namespace feature::details;
+
+TEST_CASE("Test distance_matrix::DistanceMatrix", "[distance_matrix]") {
+    // 11 home, 10 away and a referee sorted by their types
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> coord(0, 100);
+    player_seq players;
+    for (int id = 0; id < 22; ++id) {
+        const int type = id < 11 ? 0 : (id < 21 ? 1 : 2);
+        players.emplace_back(type, id, id, coord(gen), coord(gen));
+    }
+    DistanceMatrix distances;
+    distances.reset(players.cbegin(), players.cend());
+
+    SECTION("Nothing is computed before a distance is requested") {
+        REQUIRE(distances.size() == players.size());
+        REQUIRE(distances.computed_blocks() == 0);
+        REQUIRE(distances.index(players.cbegin() + 11) == 11);
+    }
+
+    SECTION("Distances are the same as dist") {
+        for (size_t i = 0; i < players.size(); ++i) {
+            for (size_t j = 0; j < players.size(); ++j) {
+                const Player& p = players[i];
+                const Player& q = players[j];
+                REQUIRE(distances(i, j) == dist(p.x, p.y, q.x, q.y));
+            }
+        }
+        // (home, away, referee) x (home, away, referee) symmetric blocks
+        REQUIRE(distances.computed_blocks() == 6);
+    }
+
+    SECTION("Blocks are computed once and reused") {
+        const double home_away = distances(3, 15);
+        REQUIRE(distances.computed_blocks() == 1);
+        REQUIRE(distances(15, 3) == home_away);
+        REQUIRE(distances(0, 20) == distances(20, 0));
+        REQUIRE(distances.computed_blocks() == 1);
+        distances.pair_sum(0, 11);
+        REQUIRE(distances.computed_blocks() == 2);
+    }
+
+    SECTION("Pair sums are the same as pairwise_distance_sum") {
+        std::vector<double> xs(pairwise_padded_size(players.size()), 0);
+        std::vector<double> ys(pairwise_padded_size(players.size()), 0);
+        for (size_t i = 0; i < players.size(); ++i) {
+            xs[i] = players[i].x;
+            ys[i] = players[i].y;
+        }
+        REQUIRE(distances.pair_sum(0, 11) ==
+                pairwise_distance_sum(xs.data(), ys.data(), 11));
+        REQUIRE(distances.pair_sum(11, 21) ==
+                pairwise_distance_sum(xs.data() + 11, ys.data() + 11, 10));
+        REQUIRE(distances.pair_sum(0, 22) ==
+                pairwise_distance_sum(xs.data(), ys.data(), 22));
+        REQUIRE(distances.pair_sum(5, 5) == 0);
+        REQUIRE(distances.pair_sum(5, 6) == 0);
+    }
+
+    SECTION("Segments of a Frame are the blocks") {
+        Frame frame;
+        frame.assign(players.cbegin(), players.cend());
+        DistanceMatrix from_frame;
+        from_frame.reset(frame);
+        REQUIRE(from_frame.size() == players.size());
+        REQUIRE(from_frame.pair_sum(0, 22) == distances.pair_sum(0, 22));
+        REQUIRE(from_frame.computed_blocks() == 6);
+        REQUIRE(from_frame(21, 4) == distances(21, 4));
+    }
+
+    SECTION("Reset starts a new frame") {
+        distances.pair_sum(0, 22);
+        players.resize(3);
+        players[0].x = 0;
+        players[0].y = 0;
+        players[1].x = 3;
+        players[1].y = 4;
+        distances.reset(players.cbegin(), players.cend());
+        REQUIRE(distances.computed_blocks() == 0);
+        REQUIRE(distances(0, 1) == 5);
+        REQUIRE(distances(1, 1) == 0);
+    }
+}
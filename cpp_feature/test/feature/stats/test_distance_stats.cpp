@@ -30,7 +30,7 @@ using namespace feature::details;
 TEST_CASE("Test distance_stats::distance_stats", "[distance_stats]") {
 
     SECTION("Test with multiple players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),   Player(78.91993306, 41.80005636),
             Player(65.03668249, 86.17347712), Player(62.24491594, 36.20383972),
             Player(74.52460286, 83.89700268), Player(34.86547034, 85.08598683),
@@ -71,10 +71,30 @@ TEST_CASE("Test distance_stats::distance_stats", "[distance_stats]") {
             REQUIRE(features[name_to_index("homeInnerDistance")] ==
                     Approx(33537.0177));
         }
+
+        SECTION("Frame spans give the same results as Player ranges") {
+            for (size_t i = 0; i < players.size(); ++i) {
+                players[i].type = i < 20 ? 0 : 1;
+            }
+            std::vector<double> expected(num_features(), -10);
+            distance_stats(players.cbegin(), players.cbegin() + 20, Team::home,
+                           expected);
+            distance_stats(players.cbegin() + 20, players.cend(), Team::away,
+                           expected);
+
+            Workspace workspace;
+            workspace.frame.assign(players.cbegin(), players.cend());
+            const Frame& frame = workspace.frame;
+            distance_stats(frame, frame.span(PlayerType::home), Team::home,
+                           workspace, features);
+            distance_stats(frame, frame.span(PlayerType::away), Team::away,
+                           workspace, features);
+            REQUIRE(features == expected);
+        }
     }
 
     SECTION("Test with a single player") {
-        std::vector<Player> players{Player(123, 456)};
+        player_seq players{Player(123, 456)};
         std::vector<double> features(num_features(), -10);
 
         distance_stats(players.begin(), players.end(), "home", features);
@@ -82,7 +102,7 @@ TEST_CASE("Test distance_stats::distance_stats", "[distance_stats]") {
     }
 
     SECTION("Test with no players") {
-        std::vector<Player> players;
+        player_seq players;
         std::vector<double> features(num_features(), -10);
 
         distance_stats(players.begin(), players.end(), "home", features);
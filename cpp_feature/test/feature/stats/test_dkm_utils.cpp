@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <random>
 #include <vector>
 
 #include <feature/stats/dkm_utils.hpp>
@@ -210,3 +211,317 @@ TEST_CASE("Test dkm_utils::get_best_means", "[dkm_utils::get_best_means]") {
         }
     }
 }
+
+/**
+ * @brief Return the lowest sum of squared distances of all 2-partitions of the
+ * given points.
+ */
+static double brute_force_two_means(const dkm_point_seq<2>& points) {
+    const size_t n = points.size();
+    double best = std::numeric_limits<double>::max();
+    for (size_t mask = 1; mask + 1 < (size_t(1) << n); ++mask) {
+        double sse = 0;
+        for (size_t label = 0; label < 2; ++label) {
+            double sum_x = 0, sum_y = 0, count = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (((mask >> i) & 1) == label) {
+                    sum_x += points[i][0];
+                    sum_y += points[i][1];
+                    count += 1;
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (((mask >> i) & 1) == label) {
+                    const double dx = points[i][0] - sum_x / count;
+                    const double dy = points[i][1] - sum_y / count;
+                    sse += dx * dx + dy * dy;
+                }
+            }
+        }
+        best = std::min(best, sse);
+    }
+    return best;
+}
+
+TEST_CASE("Test dkm_utils::TwoMeans", "[dkm_utils::TwoMeans]") {
+    TwoMeans clustering;
+
+    SECTION("Result is the optimal clustering") {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> coord(0, 100);
+        // coordinates on a small grid create collinear and same points
+        std::uniform_int_distribution<int> grid(0, 3);
+        for (int iter = 0; iter < 300; ++iter) {
+            const size_t n = 2 + iter % 11;
+            dkm_point_seq<2> points(n);
+            for (auto& point : points) {
+                if (iter % 2 == 0) {
+                    point = {coord(gen), coord(gen)};
+                } else {
+                    point = {double(grid(gen)), double(grid(gen))};
+                }
+            }
+            clustering.fit(points);
+
+            // labels and centroids match the inertia
+            const auto& labels = clustering.point_labels();
+            const auto& centroids = clustering.centroids();
+            REQUIRE(labels.size() == n);
+            REQUIRE(centroids.size() == 2);
+            double sse = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const auto& center = centroids[labels[i]];
+                sse += std::pow(dist<2>(points[i], center), 2);
+            }
+            REQUIRE(clustering.inertia() == Approx(sse));
+            REQUIRE(clustering.inertia() ==
+                    Approx(brute_force_two_means(points)).margin(1e-9));
+        }
+    }
+
+    SECTION("Two separated groups") {
+        dkm_point_seq<2> points{{0, 0}, {10, 10}, {1, 0}, {11, 10}, {0, 1}};
+        auto means = two_means(points);
+        dkm_label_seq expected{0, 1, 0, 1, 0};
+        REQUIRE(std::get<1>(means) == expected);
+        REQUIRE(std::get<0>(means)[0][0] == Approx(1. / 3));
+        REQUIRE(std::get<0>(means)[1][0] == Approx(10.5));
+    }
+
+    SECTION("Same points") {
+        dkm_point_seq<2> points{{3, 4}, {3, 4}, {3, 4}};
+        clustering.fit(points);
+        REQUIRE(clustering.inertia() == 0);
+        REQUIRE(clustering.point_labels().size() == 3);
+    }
+
+    SECTION("Single point") {
+        dkm_point_seq<2> points{{3, 4}};
+        clustering.fit(points);
+        REQUIRE(clustering.point_labels() == dkm_label_seq{0});
+        REQUIRE(clustering.centroids()[0] == points[0]);
+        REQUIRE(clustering.inertia() == 0);
+    }
+}
+
+/**
+ * @brief Return the lowest sum of squared distances of all clusterings of the
+ * given 1D points into at most n_clusters clusters.
+ */
+static double brute_force_kmeans_1d(const dkm_point_seq<1>& points,
+                                    size_t n_clusters) {
+    const size_t n = points.size();
+    size_t num_labelings = 1;
+    for (size_t i = 0; i < n; ++i) {
+        num_labelings *= n_clusters;
+    }
+    double best = std::numeric_limits<double>::max();
+    std::vector<size_t> labels(n);
+    for (size_t code = 0; code < num_labelings; ++code) {
+        size_t rest = code;
+        for (auto& label : labels) {
+            label = rest % n_clusters;
+            rest /= n_clusters;
+        }
+        double sse = 0;
+        for (size_t label = 0; label < n_clusters; ++label) {
+            double sum = 0, count = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (labels[i] == label) {
+                    sum += points[i][0];
+                    count += 1;
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (labels[i] == label) {
+                    sse += std::pow(points[i][0] - sum / count, 2);
+                }
+            }
+        }
+        best = std::min(best, sse);
+    }
+    return best;
+}
+
+TEST_CASE("Test dkm_utils::KMeans1D", "[dkm_utils::KMeans1D]") {
+    KMeans1D clustering;
+
+    SECTION("Result is the optimal clustering") {
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<double> coord(0, 100);
+        std::uniform_int_distribution<int> grid(0, 4);
+        for (int iter = 0; iter < 60; ++iter) {
+            const size_t n = 1 + iter % 7;
+            const uint32_t n_clusters = 1 + iter % 4;
+            dkm_point_seq<1> points(n);
+            for (auto& point : points) {
+                point[0] = (iter % 2 == 0) ? coord(gen) : grid(gen);
+            }
+            clustering.fit(points, n_clusters);
+
+            // labels and centroids match the inertia
+            const auto& labels = clustering.point_labels();
+            const auto& centroids = clustering.centroids();
+            REQUIRE(labels.size() == n);
+            REQUIRE(centroids.size() == n_clusters);
+            double sse = 0;
+            for (size_t i = 0; i < n; ++i) {
+                REQUIRE(labels[i] < n_clusters);
+                sse += std::pow(points[i][0] - centroids[labels[i]][0], 2);
+            }
+            REQUIRE(clustering.inertia() == Approx(sse));
+            REQUIRE(clustering.inertia() ==
+                    Approx(brute_force_kmeans_1d(points, n_clusters))
+                        .margin(1e-9));
+        }
+    }
+
+    SECTION("Clusters are labeled in increasing order") {
+        dkm_point_seq<1> points{{50}, {1}, {51}, {100}, {2}, {99}};
+        auto means = kmeans_1d(points, 3);
+        dkm_label_seq expected{1, 0, 1, 2, 0, 2};
+        REQUIRE(std::get<1>(means) == expected);
+        REQUIRE(std::get<0>(means)[0][0] == Approx(1.5));
+        REQUIRE(std::get<0>(means)[1][0] == Approx(50.5));
+        REQUIRE(std::get<0>(means)[2][0] == Approx(99.5));
+    }
+
+    SECTION("Less points than clusters") {
+        dkm_point_seq<1> points{{3}, {1}};
+        clustering.fit(points, 4);
+        REQUIRE(clustering.point_labels() == (dkm_label_seq{1, 0}));
+        REQUIRE(clustering.centroids().size() == 4);
+        REQUIRE(clustering.inertia() == 0);
+    }
+}
+
+TEST_CASE("Test dkm_utils::kmeans", "[dkm_utils::kmeans]") {
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> coord(0, 100);
+    dkm_point_seq<2> points(22);
+    for (auto& point : points) {
+        point = {coord(gen), coord(gen)};
+    }
+
+    SECTION("Same engine state gives the same clustering") {
+        kmeans_engine engine(5);
+        const dkm_means<2> means = kmeans(points, 4, 10, engine);
+        REQUIRE(std::get<0>(means).size() == 4);
+        REQUIRE(std::get<1>(means).size() == points.size());
+
+        KMeans<2> clustering;
+        kmeans_engine fit_engine(5);
+        clustering.fit(points, 4, 10, fit_engine);
+        REQUIRE(std::get<0>(means) == clustering.centroids());
+        REQUIRE(std::get<1>(means) == clustering.point_labels());
+    }
+
+    SECTION("Randomly seeded clustering") {
+        const dkm_point_seq<1> line{{0}, {1}, {10}, {11}};
+        const dkm_means<1> means = kmeans(line, 2);
+        const auto& labels = std::get<1>(means);
+        REQUIRE(labels.size() == 4);
+        REQUIRE(labels[0] == labels[1]);
+        REQUIRE(labels[2] == labels[3]);
+        REQUIRE(labels[0] != labels[2]);
+    }
+}
+
+TEST_CASE("Test dkm_utils::KMeans::fit_warm", "[dkm_utils::KMeans]") {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> coord(0, 100);
+    std::normal_distribution<double> noise(0, 0.5);
+    dkm_point_seq<2> points(22);
+    for (auto& point : points) {
+        point = {coord(gen), coord(gen)};
+    }
+
+    KMeans<2> clustering;
+    kmeans_engine engine(5);
+
+    SECTION("First call runs k-means from random initializations") {
+        REQUIRE(!clustering.fit_warm(points, 4, 10, 0.1, engine));
+
+        KMeans<2> cold;
+        kmeans_engine cold_engine(5);
+        cold.fit(points, 4, 10, cold_engine);
+        REQUIRE(clustering.centroids() == cold.centroids());
+        REQUIRE(clustering.point_labels() == cold.point_labels());
+    }
+
+    SECTION("Slightly moved points keep the warm started clustering") {
+        clustering.fit(points, 4, 10, engine);
+        const double inertia = clustering.inertia();
+        for (auto& point : points) {
+            point[0] += noise(gen);
+            point[1] += noise(gen);
+        }
+        REQUIRE(clustering.fit_warm(points, 4, 10, 0.1, engine));
+        REQUIRE(clustering.inertia() <= 1.1 * inertia);
+        REQUIRE(clustering.point_labels().size() == points.size());
+    }
+
+    SECTION("Worse clusterings are restarted") {
+        clustering.fit(points, 4, 10, engine);
+        // all the points but one are at the same place
+        for (auto& point : points) {
+            point = {50, 50};
+        }
+        points[0] = {0, 0};
+        clustering.fit_warm(points, 4, 10, 0.1, engine);
+
+        KMeans<2> cold;
+        cold.fit(points, 4, 10, engine);
+        REQUIRE(clustering.inertia() <= cold.inertia() + 1e-9);
+    }
+
+    SECTION("Different number of clusters runs k-means from scratch") {
+        clustering.fit(points, 3, 10, engine);
+        REQUIRE(!clustering.fit_warm(points, 4, 10, 0.1, engine));
+        REQUIRE(clustering.centroids().size() == 4);
+    }
+}
+
+TEST_CASE("Test dkm_utils::KMeans with RestartPolicy", "[dkm_utils::KMeans]") {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> coord(0, 100);
+    dkm_point_seq<2> points(22);
+    for (auto& point : points) {
+        point = {coord(gen), coord(gen)};
+    }
+
+    KMeans<2> clustering;
+    kmeans_engine engine(11);
+
+    SECTION("All runs are made without patience") {
+        clustering.fit(points, 4, RestartPolicy{7, 0}, engine);
+        REQUIRE(clustering.runs() == 7);
+    }
+
+    SECTION("Runs stop once patience is exhausted") {
+        // four well separated groups always give the same clustering
+        dkm_point_seq<2> groups;
+        for (double x : {0.0, 100.0}) {
+            for (double y : {0.0, 100.0}) {
+                groups.push_back({x, y});
+                groups.push_back({x + 1, y});
+                groups.push_back({x, y + 1});
+            }
+        }
+        clustering.fit(groups, 4, RestartPolicy{10, 2}, engine);
+        REQUIRE(clustering.runs() == 3);
+    }
+
+    SECTION("Early stopped clustering is the best of the runs made") {
+        clustering.fit(points, 4, RestartPolicy{10, 2}, engine);
+        REQUIRE(clustering.runs() >= 3);
+        REQUIRE(clustering.runs() <= 10);
+
+        KMeans<2> full;
+        kmeans_engine full_engine(11);
+        full.fit(points, 4, clustering.runs(), full_engine);
+        REQUIRE(clustering.centroids() == full.centroids());
+        REQUIRE(clustering.point_labels() == full.point_labels());
+        REQUIRE(clustering.inertia() == full.inertia());
+    }
+}
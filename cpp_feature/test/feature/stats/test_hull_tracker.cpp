@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <feature/player.hpp>
+#include <feature/stats/convex_hull.hpp>
+#include <feature/stats/hull_tracker.hpp>
+
+using namespace feature;
+using namespace feature::details;
+
+/**
+ * @brief Move the given players randomly and check that the hull of the
+ * tracker is the same as convex_hull in every frame. If shuffle is true, the
+ * order of the players changes in every frame.
+ */
+static void check_frames(HullTracker& tracker, player_seq& players,
+                         int num_frames, double step, std::mt19937& gen,
+                         bool shuffle = false) {
+    std::normal_distribution<double> move(0, step);
+    std::vector<int> order;
+    std::vector<int> hull;
+    for (int frame = 0; frame < num_frames; ++frame) {
+        for (auto& p : players) {
+            p.x += move(gen);
+            p.y += move(gen);
+        }
+        if (shuffle) {
+            std::shuffle(players.begin(), players.end(), gen);
+        }
+        tracker.update(players.cbegin(), players.cend(), order, hull);
+        REQUIRE(hull == convex_hull(players.cbegin(), players.cend()));
+    }
+}
+
+TEST_CASE("Test hull_tracker::HullTracker", "[hull_tracker]") {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> coord(0, 50);
+    player_seq players;
+    for (int id = 0; id < 11; ++id) {
+        players.emplace_back(0, id, id, coord(gen), coord(gen));
+    }
+    HullTracker tracker;
+
+    SECTION("Small moves repair the hull") {
+        check_frames(tracker, players, 200, 0.05, gen);
+        REQUIRE(tracker.rebuilds() < 10);
+    }
+
+    SECTION("Players are matched by id") {
+        check_frames(tracker, players, 200, 0.05, gen, true);
+        REQUIRE(tracker.rebuilds() < 10);
+    }
+
+    SECTION("Large moves rebuild the hull") {
+        check_frames(tracker, players, 200, 10, gen);
+    }
+
+    SECTION("Changed players rebuild the hull") {
+        check_frames(tracker, players, 10, 0.05, gen);
+        const size_t rebuilds = tracker.rebuilds();
+        players[3].id = 100;
+        check_frames(tracker, players, 1, 0.05, gen);
+        REQUIRE(tracker.rebuilds() == rebuilds + 1);
+
+        players.pop_back();
+        check_frames(tracker, players, 10, 0.05, gen);
+        players.clear();
+        check_frames(tracker, players, 1, 0.05, gen);
+    }
+
+    SECTION("Players at the same position or on a line") {
+        player_seq lined;
+        for (int id = 0; id < 8; ++id) {
+            lined.emplace_back(0, id, id, id % 4, id % 4);
+        }
+        check_frames(tracker, lined, 50, 0, gen);
+        check_frames(tracker, lined, 50, 0.5, gen);
+    }
+}
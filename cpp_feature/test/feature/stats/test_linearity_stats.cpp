@@ -30,7 +30,7 @@ using namespace feature::details;
 TEST_CASE("Test linearity_stats::linearity_stats", "[linearity_stats]") {
 
     SECTION("Multiple players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),   Player(78.91993306, 41.80005636),
             Player(65.03668249, 86.17347712), Player(62.24491594, 36.20383972),
             Player(74.52460286, 83.89700268), Player(34.86547034, 85.08598683),
@@ -69,7 +69,7 @@ TEST_CASE("Test linearity_stats::linearity_stats", "[linearity_stats]") {
         std::vector<double> features = default_features();
 
         SECTION("3") {
-            std::vector<Player> players{
+            player_seq players{
                 Player(742, 15),
                 Player(176, 715),
                 Player(72, 48),
@@ -80,7 +80,7 @@ TEST_CASE("Test linearity_stats::linearity_stats", "[linearity_stats]") {
         }
 
         SECTION("2") {
-            std::vector<Player> players{
+            player_seq players{
                 Player(742, 15),
                 Player(72, 48),
             };
@@ -90,7 +90,7 @@ TEST_CASE("Test linearity_stats::linearity_stats", "[linearity_stats]") {
         }
 
         SECTION("1") {
-            std::vector<Player> players{
+            player_seq players{
                 Player(742, 15),
             };
             linearity_stats(players.begin(), players.end(), features);
@@ -99,7 +99,7 @@ TEST_CASE("Test linearity_stats::linearity_stats", "[linearity_stats]") {
         }
 
         SECTION("0") {
-            std::vector<Player> players;
+            player_seq players;
             linearity_stats(players.begin(), players.end(), features);
             REQUIRE(features[name_to_index("playerVerticalLinearity")] ==
                     default_value());
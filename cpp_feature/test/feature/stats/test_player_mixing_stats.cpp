@@ -31,7 +31,7 @@ TEST_CASE("Test player_mixing_stats::player_mixing_stats",
           "[player_mixing_stats]") {
 
     SECTION("Multiple players") {
-        std::vector<Player> players{
+        player_seq players{
             Player(47.856751, 50.21719257),   Player(78.91993306, 41.80005636),
             Player(65.03668249, 86.17347712), Player(62.24491594, 36.20383972),
             Player(74.52460286, 83.89700268), Player(34.86547034, 85.08598683),
@@ -70,7 +70,7 @@ TEST_CASE("Test player_mixing_stats::player_mixing_stats",
         std::vector<double> features = default_features();
 
         SECTION("3") {
-            std::vector<Player> players{
+            player_seq players{
                 Player(742, 15),
                 Player(176, 715),
                 Player(72, 48),
@@ -81,7 +81,7 @@ TEST_CASE("Test player_mixing_stats::player_mixing_stats",
         }
 
         SECTION("2") {
-            std::vector<Player> players{
+            player_seq players{
                 Player(742, 15),
                 Player(72, 48),
             };
@@ -91,7 +91,7 @@ TEST_CASE("Test player_mixing_stats::player_mixing_stats",
         }
 
         SECTION("1") {
-            std::vector<Player> players{
+            player_seq players{
                 Player(742, 15),
             };
             player_mixing_stats(players.begin(), players.end(), features);
@@ -100,7 +100,7 @@ TEST_CASE("Test player_mixing_stats::player_mixing_stats",
         }
 
         SECTION("0") {
-            std::vector<Player> players;
+            player_seq players;
             player_mixing_stats(players.begin(), players.end(), features);
             REQUIRE(features[name_to_index("maxClusterImpurity")] ==
                     default_value());
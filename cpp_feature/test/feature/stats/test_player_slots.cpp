@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <vector>
+
+#include <feature/player.hpp>
+#include <feature/row.hpp>
+#include <feature/stats/player_slots.hpp>
+
+using namespace feature;
+using namespace feature::details;
+
+TEST_CASE("Test player_slots::PlayerSlots", "[player_slots]") {
+    PlayerSlots slots;
+    Row row;
+    row.match_id = 3;
+    row.timestamp = 100;
+    row.players = {Player(0, 17, 1, 1, 2), Player(1, 4, 2, 3, 4),
+                   Player(0, 900, 3, 5, 6)};
+
+    SECTION("Ids are interned to dense slots") {
+        REQUIRE(slots.intern(17) == 0);
+        REQUIRE(slots.intern(900) == 1);
+        REQUIRE(slots.intern(17) == 0);
+        REQUIRE(slots.size() == 2);
+        REQUIRE(slots[1].id == 900);
+        REQUIRE_FALSE(slots.in_last_row(0));
+    }
+
+    SECTION("Recorded positions are looked up by slot") {
+        std::vector<size_t> row_slots;
+        slots.prepare(row, row_slots);
+        REQUIRE((row_slots == std::vector<size_t>{0, 1, 2}));
+        slots.record(row, row_slots);
+        REQUIRE(slots.last_timestamp() == 100);
+        REQUIRE(slots.in_last_row(1));
+        REQUIRE(slots[1].x == 3);
+        REQUIRE(slots[1].y == 4);
+        REQUIRE(slots[1].timestamp == 100);
+
+        // player 4 leaves; the other players move
+        Row next = row;
+        next.timestamp = 200;
+        next.players = {Player(0, 900, 3, 7, 8), Player(0, 17, 1, 9, 10)};
+        slots.record(next);
+        REQUIRE((std::vector<size_t>{slots.intern(900), slots.intern(17)} ==
+                 std::vector<size_t>{2, 0}));
+        REQUIRE(slots.in_last_row(0));
+        REQUIRE(slots.in_last_row(2));
+        REQUIRE_FALSE(slots.in_last_row(1));
+        REQUIRE(slots[0].x == 9);
+        REQUIRE(slots[1].timestamp == 100);
+    }
+
+    SECTION("First occurrence of a repeated id is recorded") {
+        row.players.push_back(Player(2, 17, 4, 50, 60));
+        slots.record(row);
+        REQUIRE(slots.size() == 3);
+        REQUIRE(slots[0].x == 1);
+        REQUIRE(slots[0].y == 2);
+    }
+
+    SECTION("Slots are cleared for another match") {
+        slots.record(row);
+        Row other = row;
+        other.match_id = 4;
+        other.players = {Player(0, 5, 1, 0, 0)};
+        slots.record(other);
+        REQUIRE(slots.size() == 1);
+        REQUIRE(slots[0].id == 5);
+        REQUIRE(slots.in_last_row(0));
+    }
+}
@@ -30,7 +30,7 @@ using namespace feature::details;
 TEST_CASE("Test referee_stats::referee_stats", "[referee_stats]") {
 
     SECTION("Referee exists") {
-        std::vector<Player> refs{Player(47.856751, 50.21719257)};
+        player_seq refs{Player(47.856751, 50.21719257)};
         std::vector<double> speed{5.12};
         int dt = 300;
         std::vector<double> features(num_features(), -10);
@@ -57,8 +57,33 @@ TEST_CASE("Test referee_stats::referee_stats", "[referee_stats]") {
         }
     }
 
+    SECTION("Referee in a Frame") {
+        player_seq players{Player(0, 1, 1, 10, 20),
+                           Player(2, 2, 0, 30, 40),
+                           Player(2, 3, 0, 50, 60)};
+        std::vector<double> speed{1, 2, 3};
+        Frame frame;
+        frame.assign(players.cbegin(), players.cend());
+        std::vector<double> features(num_features(), -10);
+
+        const PlayerSpan referees = frame.span(PlayerType::referee);
+        referee_stats(frame, referees, speed.cbegin() + referees.first,
+                      features);
+        REQUIRE(features[name_to_index("refX")] == 30);
+        REQUIRE(features[name_to_index("refY")] == 40);
+        REQUIRE(features[name_to_index("refSpeed")] == 2);
+
+        players.resize(1);
+        frame.assign(players.cbegin(), players.cend());
+        referee_stats(frame, frame.span(PlayerType::referee), speed.cbegin(),
+                      features);
+        REQUIRE(features[name_to_index("refX")] == feature::default_value());
+        REQUIRE(features[name_to_index("refSpeed")] ==
+                feature::default_value());
+    }
+
     SECTION("Referee doesn't exist") {
-        std::vector<Player> refs;
+        player_seq refs;
         std::vector<double> speed;
         std::vector<double> features(num_features(), -10);
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <feature/stats/small_kmeans.hpp>
+
+using namespace feature::details;
+
+#ifdef __SSE2__
+
+/**
+ * @brief Scalar Lloyd's algorithm computed in the same order as KMeans.
+ */
+template <size_t N>
+static void scalar_lloyd(const std::vector<std::array<double, N>>& points,
+                         std::vector<std::array<double, N>>& means,
+                         std::vector<uint32_t>& labels) {
+    bool changed = true;
+    while (changed) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            double smallest = 0;
+            for (uint32_t m = 0; m < means.size(); ++m) {
+                double d = 0;
+                for (size_t j = 0; j < N; ++j) {
+                    d += (points[i][j] - means[m][j]) *
+                         (points[i][j] - means[m][j]);
+                }
+                if (m == 0 || d < smallest) {
+                    smallest = d;
+                    labels[i] = m;
+                }
+            }
+        }
+        auto old_means = means;
+        std::vector<std::array<double, N>> sums(means.size());
+        std::vector<double> counts(means.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            counts[labels[i]] += 1;
+            for (size_t j = 0; j < N; ++j) {
+                sums[labels[i]][j] += points[i][j];
+            }
+        }
+        for (size_t m = 0; m < means.size(); ++m) {
+            for (size_t j = 0; j < N && counts[m] != 0; ++j) {
+                means[m][j] = sums[m][j] / counts[m];
+            }
+        }
+        changed = means != old_means;
+    }
+}
+
+/**
+ * @brief Check that small_lloyd gives the same result as scalar_lloyd for
+ * random points starting from the first K points.
+ */
+template <size_t N, uint32_t K> static void check_random_points() {
+    std::mt19937 gen(K * 10 + N);
+    std::uniform_real_distribution<double> coord(-50, 50);
+    for (size_t n = K; n <= small_kmeans_capacity; ++n) {
+        std::vector<std::array<double, N>> points(n);
+        for (auto& point : points) {
+            for (auto& x : point) {
+                x = coord(gen);
+            }
+        }
+        std::vector<std::array<double, N>> means(points.begin(),
+                                                 points.begin() + K);
+        std::vector<std::array<double, N>> expected_means = means;
+        std::vector<uint32_t> labels(n), expected_labels(n);
+
+        small_lloyd<N, K>(points, means, labels);
+        scalar_lloyd<N>(points, expected_means, expected_labels);
+        REQUIRE(means == expected_means);
+        REQUIRE(labels == expected_labels);
+    }
+}
+
+TEST_CASE("Test small_kmeans::small_lloyd", "[small_kmeans::small_lloyd]") {
+    SECTION("Same as scalar implementation") {
+        check_random_points<1, 2>();
+        check_random_points<1, 4>();
+        check_random_points<2, 2>();
+        check_random_points<2, 4>();
+        check_random_points<3, 4>();
+    }
+
+    SECTION("Empty clusters keep their means") {
+        std::vector<std::array<double, 2>> points{
+            {0, 0}, {0, 1}, {10, 0}, {10, 1}, {10, 2}};
+        std::vector<std::array<double, 2>> means{
+            {0, 0}, {0, 0}, {10, 0}, {100, 100}};
+        std::vector<uint32_t> labels(points.size());
+
+        small_lloyd<2, 4>(points, means, labels);
+        std::vector<std::array<double, 2>> expected_means{
+            {0, 1}, {0, 0}, {10, 1}, {100, 100}};
+        REQUIRE(means == expected_means);
+        REQUIRE((labels == std::vector<uint32_t>{1, 0, 2, 2, 2}));
+    }
+}
+
+#endif
@@ -31,7 +31,7 @@ TEST_CASE("Test feature::details::calculate_speeds", "[calculate_speeds]") {
         auto speeds = calculate_speeds(curr, prev);
         REQUIRE(speeds.empty());
 
-        curr.players = std::vector<Player>(10);
+        curr.players = player_seq(10);
         speeds = calculate_speeds(curr, prev);
         REQUIRE(speeds.size() == 10);
     }
@@ -88,4 +88,35 @@ TEST_CASE("Test feature::details::calculate_speeds", "[calculate_speeds]") {
         for (size_t i = 0; i < speeds.size(); ++i)
             REQUIRE(speeds[i] == Approx(expected[i]).epsilon(1e-6));
     }
+
+    SECTION("Speeds using PlayerSlots are the same as using the previous "
+            "Row") {
+        Row first;
+        first.timestamp = 1000;
+        first.players = {Player(0, 1, 1, 0, 0), Player(0, 2, 2, 10, 10)};
+        Row second;
+        second.timestamp = 1500;
+        second.players = {Player(0, 2, 2, 13, 14), Player(0, 3, 3, 5, 5)};
+        Row third;
+        third.timestamp = 2500;
+        third.players = {Player(0, 3, 3, 5, 6), Player(0, 1, 1, 1, 1),
+                         Player(0, 2, 2, 13, 14)};
+
+        PlayerSlots slots;
+        std::vector<size_t> row_slots;
+        std::vector<double> speeds;
+        calculate_speeds(first, slots, row_slots, speeds);
+        REQUIRE(speeds == calculate_speeds(first, Row()));
+
+        calculate_speeds(second, slots, row_slots, speeds);
+        REQUIRE(speeds == calculate_speeds(second, first));
+        REQUIRE(speeds[0] == Approx(10));
+
+        // player 1 was not in the previous Row
+        calculate_speeds(third, slots, row_slots, speeds);
+        REQUIRE(speeds == calculate_speeds(third, second));
+        REQUIRE(speeds[0] == Approx(1));
+        REQUIRE(speeds[1] == feature::default_value());
+        REQUIRE(speeds[2] == 0);
+    }
 }
@@ -14,11 +14,74 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
 #include <vector>
 
 #include <catch/catch.hpp>
 
 #include <feature/computer.hpp>
+#include <thread_pool.hpp>
+
+/**
+ * @brief Number of calls to the global operator new.
+ */
+static std::atomic<long> num_allocations(0);
+
+void* operator new(size_t size) {
+    ++num_allocations;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+/**
+ * @brief Create consecutive rows of a match with random player positions.
+ *
+ * Some rows have no players and some rows have the same timestamp as their
+ * previous row.
+ */
+static std::vector<feature::Row> random_rows(size_t num_rows) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> x_dist(0, 105);
+    std::uniform_real_distribution<double> y_dist(0, 68);
+    std::uniform_int_distribution<int> event(0, 9);
+
+    std::vector<feature::Row> rows(num_rows);
+    long timestamp = 1000;
+    for (size_t i = 0; i < num_rows; ++i) {
+        const int e = event(gen);
+        if (e != 0) {
+            timestamp += 1000;
+        }
+        rows[i].timestamp = timestamp;
+        rows[i].half = 1;
+        if (e == 1) {
+            continue;
+        }
+        for (int id = 0; id < 23; ++id) {
+            // player 5 leaves the pitch from time to time
+            if (id == 5 && e == 2) {
+                continue;
+            }
+            const int type = (id < 11) ? 0 : (id < 22) ? 1 : 2;
+            const double x = x_dist(gen);
+            const double y = y_dist(gen);
+            rows[i].players.emplace_back(type, id, id % 11 + 1, x, y);
+        }
+    }
+    return rows;
+}
 
 TEST_CASE("Test Computer::compute_features", "[compute_features]") {
     feature::Computer fc;
@@ -35,3 +98,145 @@ TEST_CASE("Test Computer::compute_features", "[compute_features]") {
     SECTION("Test Row with some players having type == -1: They sholdn't be "
             "counted on any statistic") {}
 }
+
+/**
+ * @brief Check that computing the features of the given rows in parallel gives
+ * the same features as computing them one by one.
+ */
+static void check_parallel(const std::vector<feature::Row>& rows,
+                           bool warm_start) {
+    const auto& names = feature::feature_list();
+
+    feature::Computer sequential(0, warm_start);
+    std::vector<std::vector<double>> expected;
+    for (const auto& row : rows) {
+        expected.push_back(sequential.compute_features(row));
+    }
+
+    ThreadPool pool(3);
+    feature::Computer parallel(0, warm_start);
+    std::vector<std::vector<double>> features;
+    // split into blocks to check that state is carried between calls
+    for (size_t begin = 0; begin < rows.size(); begin += 70) {
+        const size_t end = std::min(begin + 70, rows.size());
+        std::vector<feature::Row> block(rows.begin() + begin,
+                                        rows.begin() + end);
+        for (auto& f : parallel.compute_features(block, pool)) {
+            features.push_back(f);
+        }
+    }
+    REQUIRE(parallel.compute_features({}, pool).empty());
+
+    REQUIRE(features.size() == expected.size());
+    for (size_t i = 0; i < features.size(); ++i) {
+        REQUIRE(features[i].size() == names.size());
+        REQUIRE(features[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Test parallel Computer::compute_features",
+          "[compute_features]") {
+    const std::vector<feature::Row> rows = random_rows(300);
+
+    SECTION("k-means from random initializations") {
+        check_parallel(rows, false);
+    }
+
+    SECTION("Warm started k-means") { check_parallel(rows, true); }
+}
+
+TEST_CASE("Test Computer::compute_features with ungrouped rows",
+          "[compute_features]") {
+    const std::vector<feature::Row> rows = random_rows(50);
+
+    // referees are moved in front of the players; grouping restores the
+    // original order
+    feature::Computer grouped;
+    feature::Computer ungrouped;
+    for (const auto& row : rows) {
+        feature::Row shuffled = row;
+        std::stable_partition(
+            shuffled.players.begin(), shuffled.players.end(),
+            [](const feature::Player& p) { return p.type == 2; });
+        REQUIRE(ungrouped.compute_features(shuffled) ==
+                grouped.compute_features(row));
+    }
+}
+
+TEST_CASE("Test Computer::compute_features with seeds", "[compute_features]") {
+    const std::vector<feature::Row> rows = random_rows(100);
+    const size_t impurity = feature::max_cluster_impurity_id;
+
+    feature::Computer first(7);
+    feature::Computer second(7);
+    feature::Computer other(8);
+    size_t num_different = 0;
+    for (const auto& row : rows) {
+        const auto features = first.compute_features(row);
+        REQUIRE(features == second.compute_features(row));
+        if (features[impurity] != other.compute_features(row)[impurity]) {
+            ++num_different;
+        }
+    }
+    // different seeds give different k-means initializations
+    REQUIRE(num_different > 0);
+}
+
+TEST_CASE("Test Computer::compute_features with tracked hulls",
+          "[compute_features]") {
+    // players walk a few centimetres between rows and are listed in a
+    // different order in each row, as in high-rate raw data
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> step(-0.05, 0.05);
+    std::vector<feature::Row> rows = random_rows(1);
+    for (size_t i = 1; i < 200; ++i) {
+        feature::Row row = rows.back();
+        row.timestamp += 100;
+        for (auto& player : row.players) {
+            player.x += step(gen);
+            player.y += step(gen);
+        }
+        std::shuffle(row.players.begin(), row.players.end(), gen);
+        rows.push_back(row);
+    }
+
+    feature::Computer rebuilt;
+    feature::Computer tracked(0, false, feature::details::RestartPolicy(),
+                              true);
+    for (const auto& row : rows) {
+        REQUIRE(tracked.compute_features(row) == rebuilt.compute_features(row));
+    }
+
+    // chunks of the parallel computation track their hulls separately
+    ThreadPool pool(3);
+    feature::Computer sequential;
+    feature::Computer parallel(0, false, feature::details::RestartPolicy(),
+                               true);
+    std::vector<std::vector<double>> expected;
+    for (const auto& row : rows) {
+        expected.push_back(sequential.compute_features(row));
+    }
+    REQUIRE(parallel.compute_features(rows, pool) == expected);
+}
+
+TEST_CASE("Test Computer::compute_features without allocations",
+          "[compute_features]") {
+    const std::vector<feature::Row> rows = random_rows(300);
+
+    // grow all the buffers to their largest sizes
+    feature::Computer fc;
+    std::vector<double> features;
+    for (const auto& row : rows) {
+        fc.compute_features(row, features);
+    }
+
+    const long before = num_allocations;
+    for (const auto& row : rows) {
+        fc.compute_features(row, features);
+    }
+    const long after = num_allocations;
+
+    REQUIRE(before > 0);
+    REQUIRE(features.size() == feature::num_features());
+    REQUIRE(after == before);
+}
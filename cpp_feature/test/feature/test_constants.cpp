@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <feature/constants.hpp>
+
+using namespace feature;
+
+TEST_CASE("Test constants::feature_index", "[feature_index]") {
+    const std::vector<std::string> names = feature_list();
+
+    SECTION("Feature list is sorted and IDs are positions in the list") {
+        REQUIRE(std::is_sorted(names.begin(), names.end()));
+        REQUIRE(names.size() == num_features());
+        for (size_t i = 0; i < names.size(); ++i) {
+            REQUIRE(name_to_index(names[i]) == static_cast<int>(i));
+            REQUIRE(index_to_name(i) == names[i]);
+        }
+    }
+
+    SECTION("Compile time indices are the same as name_to_index") {
+        const std::vector<std::string> prefixes{"home", "away", "player"};
+        const std::vector<std::string> suffixes{
+            "AvgX",
+            "AvgY",
+            "ConvexCenterX",
+            "ConvexCenterY",
+            "ConvexClosestDistance",
+            "ConvexFarDistance",
+            "ConvexMaxSpeed",
+            "ConvexMaxX",
+            "ConvexMaxY",
+            "ConvexMinX",
+            "ConvexMinY",
+            "DenseClusterDensity",
+            "InnerDistance",
+            "SparseClusterDensity",
+            "VerticalLinearity"};
+        REQUIRE(suffixes.size() == static_cast<size_t>(Stat::count));
+
+        for (size_t t = 0; t < prefixes.size(); ++t) {
+            const Team team = prefix_to_team(prefixes[t]);
+            REQUIRE(static_cast<size_t>(team) == t);
+            for (size_t s = 0; s < suffixes.size(); ++s) {
+                const std::string name = prefixes[t] + suffixes[s];
+                const int index = feature_index(team, static_cast<Stat>(s));
+                if (std::binary_search(names.begin(), names.end(), name)) {
+                    REQUIRE(index == name_to_index(name));
+                } else {
+                    REQUIRE(index == -1);
+                }
+            }
+        }
+
+        REQUIRE(max_cluster_impurity_id == name_to_index("maxClusterImpurity"));
+        REQUIRE(ref_speed_id == name_to_index("refSpeed"));
+        REQUIRE(ref_x_id == name_to_index("refX"));
+        REQUIRE(ref_y_id == name_to_index("refY"));
+    }
+
+    SECTION("Indices are compile time constants") {
+        static_assert(feature_index(Team::home, Stat::AvgX) == 14, "");
+        static_assert(feature_index(Team::player, Stat::AvgX) == -1, "");
+        REQUIRE(name_to_index("homeAvgX") == 14);
+    }
+
+    SECTION("Unknown prefix throws") {
+        REQUIRE_THROWS_AS(prefix_to_team("ref"), const std::out_of_range&);
+    }
+}
+
+TEST_CASE("Test constants::PlayerType", "[PlayerType]") {
+    for (const std::string name :
+         {"home", "away", "referee", "home_gk", "away_gk"}) {
+        const int type = player_name_to_type(name);
+        REQUIRE(player_type_to_name(type) == name);
+    }
+    REQUIRE(static_cast<int>(PlayerType::home) == player_name_to_type("home"));
+    REQUIRE(static_cast<int>(PlayerType::away) == player_name_to_type("away"));
+    REQUIRE(static_cast<int>(PlayerType::referee) ==
+            player_name_to_type("referee"));
+    REQUIRE(static_cast<int>(PlayerType::home_gk) ==
+            player_name_to_type("home_gk"));
+    REQUIRE(static_cast<int>(PlayerType::away_gk) ==
+            player_name_to_type("away_gk"));
+}
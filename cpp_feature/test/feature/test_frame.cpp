@@ -0,0 +1,91 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <feature/frame.hpp>
+#include <feature/player.hpp>
+#include <pairwise_distance.hpp>
+
+using namespace feature;
+
+TEST_CASE("Test Frame", "[Frame]") {
+    // home, away, a referee, an away goalkeeper and an unknown type
+    const player_seq players{
+        Player(0, 1, 1, 10, 20), Player(0, 2, 2, 30, 40),
+        Player(1, 3, 3, 50, 60), Player(2, 4, 0, 70, 80),
+        Player(4, 5, 1, 90, 100), Player(9, 6, 0, 1, 2)};
+    Frame frame;
+    frame.assign(players.cbegin(), players.cend());
+
+    SECTION("Players are stored in structure of arrays layout") {
+        REQUIRE(frame.size() == players.size());
+        for (size_t i = 0; i < players.size(); ++i) {
+            REQUIRE(frame.x()[i] == players[i].x);
+            REQUIRE(frame.y()[i] == players[i].y);
+            REQUIRE(frame.id()[i] == players[i].id);
+        }
+        REQUIRE(reinterpret_cast<uintptr_t>(frame.x()) % simd_alignment == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(frame.y()) % simd_alignment == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(frame.id()) % simd_alignment ==
+                0);
+    }
+
+    SECTION("Spans of the player types") {
+        auto check = [&frame](PlayerType type, size_t first, size_t last) {
+            const PlayerSpan span = frame.span(type);
+            REQUIRE(span.first == first);
+            REQUIRE(span.last == last);
+        };
+        check(PlayerType::home, 0, 2);
+        check(PlayerType::away, 2, 3);
+        check(PlayerType::referee, 3, 4);
+        check(PlayerType::home_gk, 4, 4);
+        check(PlayerType::away_gk, 4, 5);
+        check(PlayerType::count, 5, 6);
+        REQUIRE(frame.span(PlayerType::home_gk).empty());
+
+        const PlayerSpan both = frame.span(PlayerType::home, PlayerType::away);
+        REQUIRE(both.first == 0);
+        REQUIRE(both.size() == 3);
+    }
+
+    SECTION("Spans can be given to the pairwise distance kernels") {
+        const PlayerSpan home = frame.span(PlayerType::home);
+        REQUIRE(pairwise_distance_sum(frame.x() + home.first,
+                                      frame.y() + home.first,
+                                      home.size()) == Approx(28.2842712475));
+    }
+
+    SECTION("Empty frame") {
+        player_seq empty;
+        frame.assign(empty.cbegin(), empty.cend());
+        REQUIRE(frame.size() == 0);
+        REQUIRE(frame.span(PlayerType::home).empty());
+        REQUIRE(frame.span(PlayerType::count).empty());
+    }
+
+    SECTION("Players that are not grouped throw") {
+        player_seq ungrouped{Player(1, 1, 1, 0, 0),
+                             Player(0, 2, 2, 0, 0)};
+        REQUIRE_THROWS_AS(frame.assign(ungrouped.cbegin(), ungrouped.cend()),
+                          const std::runtime_error&);
+    }
+}
@@ -28,20 +28,59 @@ using namespace feature::details;
 TEST_CASE("Test Row::Row", "[Row::Row]") {
     Row r1;
     r1.match_id = r1.timestamp = r1.half = r1.minute = r1.second = -1;
-    r1.players = std::vector<Player>();
+    r1.players = player_seq();
 
     CHECK(r1.match_id == -1);
     CHECK(r1.timestamp == -1);
     CHECK(r1.half == -1);
     CHECK(r1.minute == -1);
     CHECK(r1.second == -1);
-    CHECK(r1.players == std::vector<Player>());
+    CHECK(r1.players == player_seq());
 }
 
 TEST_CASE("Test Row equality operators", "[Row::operator==]") {
     Row r;
     r.match_id = r.timestamp = r.half = r.minute = r.second = -1;
-    r.players = std::vector<Player>();
+    r.players = player_seq();
 
     REQUIRE(r == Row());
 }
+
+TEST_CASE("Test group_by_type", "[group_by_type]") {
+    SECTION("Known types are grouped in order and others are last") {
+        REQUIRE(type_group(0) == 0);
+        REQUIRE(type_group(4) == 4);
+        REQUIRE(type_group(5) == static_cast<size_t>(PlayerType::count));
+        REQUIRE(type_group(-1) == static_cast<size_t>(PlayerType::count));
+    }
+
+    SECTION("Players of the same group keep their order") {
+        player_seq players{
+            Player(1, 10, 0, 0, 0), Player(7, 11, 0, 0, 0),
+            Player(0, 12, 0, 0, 0), Player(2, 13, 0, 0, 0),
+            Player(1, 14, 0, 0, 0), Player(-3, 15, 0, 0, 0),
+            Player(0, 16, 0, 0, 0), Player(4, 17, 0, 0, 0)};
+        REQUIRE_FALSE(grouped_by_type(players));
+        group_by_type(players);
+        REQUIRE(grouped_by_type(players));
+
+        std::vector<int> ids;
+        for (const auto& p : players) {
+            ids.push_back(p.id);
+        }
+        REQUIRE((ids == std::vector<int>{12, 16, 10, 14, 13, 17, 11, 15}));
+    }
+
+    SECTION("Grouped players are not changed") {
+        player_seq players{Player(0, 1, 0, 0, 0),
+                           Player(0, 2, 0, 0, 0),
+                           Player(3, 3, 0, 0, 0)};
+        const player_seq expected = players;
+        group_by_type(players);
+        REQUIRE(players == expected);
+
+        player_seq empty;
+        group_by_type(empty);
+        REQUIRE(empty.empty());
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include <csv_writer.hpp>
+#include <utils.hpp>
+
+TEST_CASE("Test CsvWriter", "[CsvWriter]") {
+    const std::string filepath = "test_csv_writer.csv";
+
+    SECTION("Values are written in the same format as iostreams") {
+        {
+            CsvWriter writer(filepath);
+            writer.write(std::string("half,x"));
+            writer.end_row();
+            writer.write(2);
+            writer.write(',');
+            writer.write(-0.52);
+            writer.end_row();
+            writer.write(-123456789L);
+            writer.write(',');
+            writer.write(52.94);
+            writer.end_row();
+        }
+        REQUIRE(read_bytes(filepath) == "half,x\n"
+                                        "2,-0.520000000000\n"
+                                        "-123456789,52.940000000000\n");
+    }
+
+    SECTION("Small buffers are flushed in chunks") {
+        std::string expected;
+        {
+            CsvWriter writer(filepath, 2, 1);
+            for (int i = 0; i < 1000; ++i) {
+                writer.write(i);
+                writer.write(',');
+                writer.write(i / 4.0);
+                writer.end_row();
+
+                char line[64];
+                std::snprintf(line, sizeof(line), "%d,%.2f\n", i, i / 4.0);
+                expected += line;
+            }
+        }
+        REQUIRE(read_bytes(filepath) == expected);
+    }
+
+    SECTION("Shortest round trip representation") {
+        {
+            CsvWriter writer(filepath, CsvWriter::shortest);
+            writer.write(0.1);
+            writer.write(',');
+            writer.write(80.03);
+        }
+        REQUIRE(read_bytes(filepath) == "0.1,80.03");
+    }
+
+    SECTION("Invalid precision throws") {
+        REQUIRE_THROWS(CsvWriter(filepath, -5));
+    }
+
+    std::remove(filepath.c_str());
+}
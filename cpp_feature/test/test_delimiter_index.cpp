@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <delimiter_index.hpp>
+
+/**
+ * @brief Return a random string of the given size that consists of digits and
+ * delimiters.
+ */
+static std::string random_line(size_t size, std::mt19937& gen) {
+    const std::string chars = "0123456789.-\t ,\n";
+    std::uniform_int_distribution<size_t> pick(0, chars.size() - 1);
+    std::string line(size, ' ');
+    for (auto& c : line) {
+        c = chars[pick(gen)];
+    }
+    return line;
+}
+
+TEST_CASE("Test scan_delimiters", "[scan_delimiters]") {
+    const std::vector<SimdLevel> levels = {SimdLevel::scalar, SimdLevel::sse2,
+                                           SimdLevel::avx2, SimdLevel::avx512};
+
+    SECTION("Number of blocks") {
+        REQUIRE(delimiter_blocks(0) == 0);
+        REQUIRE(delimiter_blocks(1) == 1);
+        REQUIRE(delimiter_blocks(delimiter_block_size) == 1);
+        REQUIRE(delimiter_blocks(delimiter_block_size + 1) == 2);
+    }
+
+    SECTION("Masks of a short line") {
+        const std::string line = "1\t2 3,4\n5";
+        for (SimdLevel level : levels) {
+            DelimiterMasks masks;
+            scan_delimiters(line.data(), line.data() + line.size(), &masks,
+                            level);
+            REQUIRE(masks.tab == 0x2);
+            REQUIRE(masks.space == 0x8);
+            REQUIRE(masks.comma == 0x20);
+            REQUIRE(masks.newline == 0x80);
+            REQUIRE(masks.select(delim_tab | delim_comma) == 0x22);
+        }
+    }
+
+    SECTION("All kernels give the same masks") {
+        std::mt19937 gen(25);
+        // the range starts at every alignment and ends in every position of
+        // the last block
+        const std::string buffer = random_line(300, gen);
+        for (size_t first = 0; first < 16; ++first) {
+            for (size_t size = 0; size + first <= buffer.size(); ++size) {
+                const char* begin = buffer.data() + first;
+                const char* end = begin + size;
+                std::vector<DelimiterMasks> expected(delimiter_blocks(size));
+                scan_delimiters(begin, end, expected.data(),
+                                SimdLevel::scalar);
+                for (SimdLevel level : levels) {
+                    std::vector<DelimiterMasks> masks(delimiter_blocks(size));
+                    scan_delimiters(begin, end, masks.data(), level);
+                    for (size_t k = 0; k < masks.size(); ++k) {
+                        REQUIRE(masks[k].tab == expected[k].tab);
+                        REQUIRE(masks[k].space == expected[k].space);
+                        REQUIRE(masks[k].comma == expected[k].comma);
+                        REQUIRE(masks[k].newline == expected[k].newline);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test DelimiterIndex", "[DelimiterIndex]") {
+    std::mt19937 gen(7);
+    DelimiterIndex index;
+
+    SECTION("find is the same as searching the bytes") {
+        const std::string line = random_line(200, gen);
+        const char* begin = line.data();
+        index.scan(begin, begin + line.size());
+        for (size_t from = 0; from <= line.size(); from += 3) {
+            for (size_t last = from; last <= line.size(); last += 7) {
+                const size_t space = line.find(' ', from);
+                const size_t expected = std::min(space, last);
+                REQUIRE(index.find(begin + from, begin + last, delim_space) ==
+                        begin + expected);
+            }
+        }
+    }
+
+    SECTION("Missing delimiters give the end of the search") {
+        const std::string line(130, '7');
+        const char* begin = line.data();
+        index.scan(begin, begin + line.size());
+        REQUIRE(index.find(begin, begin + line.size(), delim_tab) ==
+                begin + line.size());
+        REQUIRE(index.find(begin + 64, begin + 64, delim_tab) == begin + 64);
+
+        index.scan(begin, begin);
+        REQUIRE(index.find(begin, begin, delim_comma) == begin);
+    }
+}
+
+TEST_CASE("Test DelimiterStream", "[DelimiterStream]") {
+    std::mt19937 gen(11);
+    DelimiterIndex index;
+    const std::string line = random_line(300, gen);
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+    index.scan(begin, end);
+
+    SECTION("Stream is the same as repeated find") {
+        const unsigned delims = delim_tab | delim_space | delim_comma;
+        for (size_t from = 0; from <= line.size(); from += 13) {
+            for (size_t last = from; last <= line.size(); last += 29) {
+                DelimiterStream stream(index, begin + from, begin + last,
+                                       delims);
+                const char* expected = begin + from;
+                do {
+                    expected = index.find(expected, begin + last, delims);
+                    REQUIRE(stream.next() == expected);
+                    expected = std::min(expected + 1, begin + last);
+                } while (expected != begin + last);
+                REQUIRE(stream.next() == begin + last);
+            }
+        }
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <double_format.hpp>
+
+/**
+ * @brief Return the output of std::snprintf with %.*f format.
+ */
+static std::string snprintf_fixed(double value, int precision) {
+    char buffer[max_formatted_double_size];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    return buffer;
+}
+
+/**
+ * @brief Return the output of format_fixed as a string.
+ */
+static std::string fixed(double value, int precision) {
+    char buffer[max_formatted_double_size];
+    char* end = format_fixed(value, precision, buffer);
+    return std::string(buffer, end);
+}
+
+/**
+ * @brief Return the output of format_shortest as a string.
+ */
+static std::string shortest(double value) {
+    char buffer[max_formatted_double_size];
+    char* end = format_shortest(value, buffer);
+    return std::string(buffer, end);
+}
+
+TEST_CASE("Test double_format::format_fixed", "[format_fixed]") {
+    SECTION("Special values") {
+        std::vector<double> values{0.0,
+                                   -0.0,
+                                   -1,
+                                   0.5,
+                                   1.5,
+                                   2.5,
+                                   -2.5,
+                                   0.125,
+                                   1e-13,
+                                   -1e-13,
+                                   5e-13,
+                                   105 - 52.94,
+                                   std::numeric_limits<double>::max(),
+                                   std::numeric_limits<double>::lowest(),
+                                   std::numeric_limits<double>::min(),
+                                   std::numeric_limits<double>::denorm_min(),
+                                   std::numeric_limits<double>::infinity(),
+                                   std::numeric_limits<double>::quiet_NaN()};
+        for (double value : values) {
+            for (int precision = 0; precision <= max_fixed_precision;
+                 ++precision) {
+                REQUIRE(fixed(value, precision) ==
+                        snprintf_fixed(value, precision));
+            }
+        }
+    }
+
+    SECTION("Random values of all magnitudes") {
+        std::mt19937_64 engine(1234);
+        std::uniform_real_distribution<double> mantissa(-1, 1);
+        std::uniform_int_distribution<int> exponent(-30, 30);
+        for (int i = 0; i < 20000; ++i) {
+            double value = std::ldexp(mantissa(engine), exponent(engine));
+            int precision = i % 18;
+            REQUIRE(fixed(value, precision) ==
+                    snprintf_fixed(value, precision));
+        }
+    }
+
+    SECTION("Values with two decimals as in raw data") {
+        for (int i = -10500; i <= 10500; ++i) {
+            double value = i / 100.0;
+            REQUIRE(fixed(value, 12) == snprintf_fixed(value, 12));
+            REQUIRE(fixed(value, 1) == snprintf_fixed(value, 1));
+        }
+    }
+}
+
+TEST_CASE("Test double_format::format_shortest", "[format_shortest]") {
+    SECTION("Short representations are used when possible") {
+        REQUIRE(shortest(0.1) == "0.1");
+        REQUIRE(shortest(52.94) == "52.94");
+        REQUIRE(shortest(-1) == "-1");
+        REQUIRE(shortest(0) == "0");
+        REQUIRE(shortest(1e-05) == "1e-05");
+    }
+
+    SECTION("Output converts back to the same double") {
+        std::mt19937_64 engine(4321);
+        std::uniform_real_distribution<double> dist(-1000, 1000);
+        for (int i = 0; i < 10000; ++i) {
+            double value = dist(engine);
+            REQUIRE(std::strtod(shortest(value).c_str(), nullptr) == value);
+        }
+        double third = 1.0 / 3;
+        REQUIRE(std::strtod(shortest(third).c_str(), nullptr) == third);
+    }
+
+    SECTION("Notation is the same as %g") {
+        REQUIRE(shortest(-0.0) == "-0");
+        REQUIRE(shortest(0.0001) == "0.0001");
+        REQUIRE(shortest(123456789012345.0) == "123456789012345");
+        REQUIRE(shortest(1e15) == "1e+15");
+        REQUIRE(shortest(1234567890123456.0) == "1234567890123456");
+        REQUIRE(shortest(12345678901234568.0) == "12345678901234568");
+        REQUIRE(shortest(123456789012345680.0) == "1.2345678901234568e+17");
+        REQUIRE(shortest(0.30000000000000004) == "0.30000000000000004");
+        REQUIRE(shortest(1.0 / 3) == "0.3333333333333333");
+    }
+
+    SECTION("Values below a power of 2 and outside the exact range") {
+        // the interval below a power of 2 is narrower; 16 digits suffice
+        REQUIRE(shortest(std::ldexp(1, -24)) == "5.960464477539063e-08");
+        REQUIRE(shortest(1e-20) == "1e-20");
+        REQUIRE(shortest(1e20) == "1e+20");
+        REQUIRE(shortest(5e-324) == "4.94065645841247e-324");
+    }
+
+    SECTION("Output is the shortest %g output that round trips") {
+        std::mt19937_64 engine(1234);
+        std::uniform_real_distribution<double> dist(0, 105);
+        char buffer[max_formatted_double_size];
+        for (int i = 0; i < 10000; ++i) {
+            const double value = std::round(dist(engine) * 1000) / 1000;
+            int precision = 15;
+            while (true) {
+                std::snprintf(buffer, sizeof(buffer), "%.*g", precision,
+                              value);
+                if (std::strtod(buffer, nullptr) == value) {
+                    break;
+                }
+                ++precision;
+            }
+            REQUIRE(shortest(value) == buffer);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <feature_writer.hpp>
+#include <utils.hpp>
+
+/**
+ * @brief Read a value of type T at the given byte offset of the given bytes.
+ */
+template <typename T> static T read_at(const std::string& bytes, size_t pos) {
+    T value;
+    std::memcpy(&value, bytes.data() + pos, sizeof(T));
+    return value;
+}
+
+TEST_CASE("Test FeatureWriter", "[FeatureWriter]") {
+    const std::string filepath = "test_feature_writer.out";
+    const std::vector<std::string> names{"a", "bb"};
+
+    SECTION("CSV format") {
+        auto writer = make_feature_writer("csv", filepath, names, 2);
+        writer->write_row(1, 2, 3, {0.5, -1});
+        writer->close();
+        REQUIRE(read_bytes(filepath) == "half,minute,second,a,bb\n"
+                                        "1,2,3,0.50,-1.00\n");
+    }
+
+    SECTION("npy format") {
+        auto writer = make_feature_writer("npy", filepath, names, 12);
+        writer->write_row(1, 2, 3, {0.5, -1});
+        writer->write_row(2, 45, 0, {7, 8});
+        writer->close();
+
+        std::string bytes = read_bytes(filepath);
+        REQUIRE(bytes.compare(0, 8, std::string("\x93NUMPY\x01\x00", 8)) ==
+                0);
+        const size_t header_len =
+            static_cast<unsigned char>(bytes[8]) +
+            256 * static_cast<unsigned char>(bytes[9]);
+        const size_t data_begin = 10 + header_len;
+        REQUIRE(data_begin % 64 == 0);
+
+        std::string header = bytes.substr(10, header_len);
+        REQUIRE(header.find("('half', '<f8'), ('minute', '<f8'), "
+                            "('second', '<f8'), ('a', '<f8'), "
+                            "('bb', '<f8')") != std::string::npos);
+        REQUIRE(header.find("'shape': (2,)") != std::string::npos);
+        REQUIRE(header.back() == '\n');
+
+        REQUIRE(bytes.size() == data_begin + 2 * 5 * sizeof(double));
+        REQUIRE(read_at<double>(bytes, data_begin) == 1);
+        REQUIRE(read_at<double>(bytes, data_begin + 4 * 8) == -1);
+        REQUIRE(read_at<double>(bytes, data_begin + 6 * 8) == 45);
+    }
+
+    SECTION("columnar format") {
+        auto writer = make_feature_writer("columnar", filepath, names, 12);
+        writer->write_row(1, 2, 3, {0.5, -1});
+        writer->write_row(2, 45, 0, {7, 8});
+        writer->close();
+
+        std::string bytes = read_bytes(filepath);
+        REQUIRE(bytes.compare(0, 8, std::string("SIUFEAT\0", 8)) == 0);
+        REQUIRE(read_at<uint32_t>(bytes, 8) == 1);
+        REQUIRE(read_at<uint32_t>(bytes, 12) == 5);
+        REQUIRE(read_at<uint64_t>(bytes, 16) == 2);
+
+        const uint64_t data_offset = read_at<uint64_t>(bytes, 24);
+        REQUIRE(data_offset % 8 == 0);
+        REQUIRE(read_at<uint32_t>(bytes, 32) == 4);
+        REQUIRE(bytes.substr(36, 4) == "half");
+
+        REQUIRE(bytes.size() == data_offset + 2 * 5 * sizeof(double));
+        // column "a"
+        REQUIRE(read_at<double>(bytes, data_offset + 6 * 8) == 0.5);
+        REQUIRE(read_at<double>(bytes, data_offset + 7 * 8) == 7);
+        // column "minute"
+        REQUIRE(read_at<double>(bytes, data_offset + 2 * 8) == 2);
+        REQUIRE(read_at<double>(bytes, data_offset + 3 * 8) == 45);
+    }
+
+    SECTION("Unknown format throws") {
+        REQUIRE_THROWS(make_feature_writer("xml", filepath, names, 12));
+    }
+
+    std::remove(filepath.c_str());
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <pairwise_distance.hpp>
+#include <utils.hpp>
+
+/**
+ * @brief Sum of distances of all pairs as computed before the kernels.
+ */
+static double naive_distance_sum(const std::vector<double>& xs,
+                                 const std::vector<double>& ys, size_t n) {
+    double sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            sum += dist(xs[i], ys[i], xs[j], ys[j]);
+        }
+    }
+    return sum;
+}
+
+TEST_CASE("Test pairwise_distance_sum", "[pairwise_distance_sum]") {
+    const std::vector<SimdLevel> levels = {SimdLevel::scalar, SimdLevel::sse2,
+                                           SimdLevel::avx2, SimdLevel::avx512};
+
+    SECTION("Padded size is a multiple of the lanes") {
+        REQUIRE(pairwise_padded_size(0) == 0);
+        REQUIRE(pairwise_padded_size(1) == pairwise_lanes);
+        REQUIRE(pairwise_padded_size(pairwise_lanes) == pairwise_lanes);
+        REQUIRE(pairwise_padded_size(pairwise_lanes + 1) == 2 * pairwise_lanes);
+    }
+
+    SECTION("Less than two points") {
+        std::vector<double> xs(pairwise_lanes, 3);
+        std::vector<double> ys(pairwise_lanes, 4);
+        for (SimdLevel level : levels) {
+            REQUIRE(pairwise_distance_sum(xs.data(), ys.data(), 0, level) == 0);
+            REQUIRE(pairwise_distance_sum(xs.data(), ys.data(), 1, level) == 0);
+        }
+    }
+
+    SECTION("Simple points") {
+        // (0, 0), (3, 4), (6, 8): 5 + 10 + 5
+        std::vector<double> xs = {0, 3, 6, 0, 0, 0, 0, 0};
+        std::vector<double> ys = {0, 4, 8, 0, 0, 0, 0, 0};
+        for (SimdLevel level : levels) {
+            REQUIRE(pairwise_distance_sum(xs.data(), ys.data(), 3, level) ==
+                    20);
+        }
+    }
+
+    SECTION("Padding values are ignored") {
+        std::vector<double> xs = {0, 3, 6, 1e300, -1e300, 7, 7, 7};
+        std::vector<double> ys = {0, 4, 8, 1e300, 1e300, 7, 7, 7};
+        for (SimdLevel level : levels) {
+            REQUIRE(pairwise_distance_sum(xs.data(), ys.data(), 3, level) ==
+                    20);
+        }
+    }
+
+    SECTION("All kernels match the scalar reference and the naive sum") {
+        std::mt19937 engine(42);
+        std::uniform_real_distribution<double> dist_x(-60, 60);
+        std::uniform_real_distribution<double> dist_y(-40, 40);
+        for (size_t n = 0; n <= 40; ++n) {
+            std::vector<double> xs(pairwise_padded_size(n), 0);
+            std::vector<double> ys(pairwise_padded_size(n), 0);
+            for (size_t i = 0; i < n; ++i) {
+                xs[i] = dist_x(engine);
+                ys[i] = dist_y(engine);
+            }
+
+            const double reference = pairwise_distance_sum(
+                xs.data(), ys.data(), n, SimdLevel::scalar);
+            REQUIRE(reference == Approx(naive_distance_sum(xs, ys, n)));
+            for (SimdLevel level : levels) {
+                REQUIRE(pairwise_distance_sum(xs.data(), ys.data(), n,
+                                              level) == reference);
+            }
+            REQUIRE(pairwise_distance_sum(xs.data(), ys.data(), n) ==
+                    reference);
+        }
+    }
+}
+
+TEST_CASE("Test point_distances", "[point_distances]") {
+    std::mt19937 engine(7);
+    std::uniform_real_distribution<double> coord(-50, 50);
+    for (size_t n = 0; n <= 13; ++n) {
+        std::vector<double> xs(n);
+        std::vector<double> ys(n);
+        for (size_t j = 0; j < n; ++j) {
+            xs[j] = coord(engine);
+            ys[j] = coord(engine);
+        }
+        const double x = coord(engine);
+        const double y = coord(engine);
+        for (SimdLevel level : {SimdLevel::scalar, SimdLevel::sse2,
+                                SimdLevel::avx2, SimdLevel::avx512}) {
+            // one extra element to check that nothing is written past n
+            std::vector<double> out(n + 1, -1);
+            point_distances(x, y, xs.data(), ys.data(), n, out.data(), level);
+            for (size_t j = 0; j < n; ++j) {
+                REQUIRE(out[j] == dist(x, y, xs[j], ys[j]));
+            }
+            REQUIRE(out[n] == -1);
+        }
+    }
+}
+
+TEST_CASE("Test simd_level", "[simd_level]") {
+    REQUIRE(simd_level() == simd_level());
+    REQUIRE(std::string(simd_level_name(simd_level())) != "unknown");
+    REQUIRE(std::string(simd_level_name(SimdLevel::avx2)) == "avx2");
+}
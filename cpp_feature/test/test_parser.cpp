@@ -16,6 +16,10 @@
 
 #include <catch/catch.hpp>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <feature/constants.hpp>
 #include <feature/player.hpp>
 #include <feature/row.hpp>
@@ -37,31 +41,31 @@ TEST_CASE("Test parser::parse_line", "[parser::parse_line]") {
             "6012,0,7,75.38,26.2 5433,1,19,78.81,54.66 5757,0,39,88.01,30.63 "
             "5722,0,33,48.78,40.87 5990,0,8,61.65,32.3 5876,1,25,79.99,19.66 "
             "5840,0,28,83.62,41.41 6100,0,17,72.82,50.32 ";
-        std::vector<Player> players{Player(4955, 0, 3, 52.94, 19.45),
-                                    Player(5264, 1, 14, 80.03, 47.38),
-                                    Player(5844, 1, 6, 76.54, 33.21),
-                                    Player(4886, 1, 18, 56.07, 16.18),
-                                    Player(6116, 6, 0, 91.82, 68.8),
-                                    Player(4933, 1, 9, 49.06, 34.72),
-                                    Player(6080, 1, 11, 55.06, 56.11),
-                                    Player(6117, 7, 0, 48, 0.52),
-                                    Player(4934, 0, 37, 49.27, 31.62),
-                                    Player(6081, 0, 19, 52.94, 55.03),
-                                    Player(6118, 1, -1, 104.79, 41.69),
-                                    Player(6079, 0, 89, 72.26, 43.93),
-                                    Player(5241, 1, 35, 85.37, 38.82),
-                                    Player(5827, 3, 1, 10.94, 34.52),
-                                    Player(6047, 1, 26, 85.21, 24.03),
-                                    Player(6089, 1, 17, 74.45, 44.34),
-                                    Player(5469, 2, 0, 65.47, 42.17),
-                                    Player(6012, 0, 7, 75.38, 26.2),
-                                    Player(5433, 1, 19, 78.81, 54.66),
-                                    Player(5757, 0, 39, 88.01, 30.63),
-                                    Player(5722, 0, 33, 48.78, 40.87),
-                                    Player(5990, 0, 8, 61.65, 32.3),
-                                    Player(5876, 1, 25, 79.99, 19.66),
-                                    Player(5840, 0, 28, 83.62, 41.41),
-                                    Player(6100, 0, 17, 72.82, 50.32)};
+        player_seq players{Player(4955, 0, 3, 52.94, 19.45),
+                           Player(5264, 1, 14, 80.03, 47.38),
+                           Player(5844, 1, 6, 76.54, 33.21),
+                           Player(4886, 1, 18, 56.07, 16.18),
+                           Player(6116, 6, 0, 91.82, 68.8),
+                           Player(4933, 1, 9, 49.06, 34.72),
+                           Player(6080, 1, 11, 55.06, 56.11),
+                           Player(6117, 7, 0, 48, 0.52),
+                           Player(4934, 0, 37, 49.27, 31.62),
+                           Player(6081, 0, 19, 52.94, 55.03),
+                           Player(6118, 1, -1, 104.79, 41.69),
+                           Player(6079, 0, 89, 72.26, 43.93),
+                           Player(5241, 1, 35, 85.37, 38.82),
+                           Player(5827, 3, 1, 10.94, 34.52),
+                           Player(6047, 1, 26, 85.21, 24.03),
+                           Player(6089, 1, 17, 74.45, 44.34),
+                           Player(5469, 2, 0, 65.47, 42.17),
+                           Player(6012, 0, 7, 75.38, 26.2),
+                           Player(5433, 1, 19, 78.81, 54.66),
+                           Player(5757, 0, 39, 88.01, 30.63),
+                           Player(5722, 0, 33, 48.78, 40.87),
+                           Player(5990, 0, 8, 61.65, 32.3),
+                           Player(5876, 1, 25, 79.99, 19.66),
+                           Player(5840, 0, 28, 83.62, 41.41),
+                           Player(6100, 0, 17, 72.82, 50.32)};
         Row row = parse_line(line);
 
         REQUIRE(row.match_id == 116001217);
@@ -70,6 +74,8 @@ TEST_CASE("Test parser::parse_line", "[parser::parse_line]") {
         REQUIRE(row.minute == 58);
         REQUIRE(row.second == 27);
         REQUIRE(row.players == players);
+        // a frame fits in the inline storage of the row
+        REQUIRE(row.players.is_inline());
     }
 
     SECTION("Parse a line with no player data") {
@@ -82,6 +88,110 @@ TEST_CASE("Test parser::parse_line", "[parser::parse_line]") {
         REQUIRE(row.half == 2);
         REQUIRE(row.minute == 58);
         REQUIRE(row.second == 27);
-        REQUIRE(row.players == std::vector<Player>());
+        REQUIRE(row.players == player_seq());
+    }
+
+    SECTION("Malformed lines throw") {
+        for (const std::string line :
+             {"", "116001217	78392209	2	58",
+              "116001217	78392209	2	58	27	4955,0,3,52.94	",
+              "116001217	78392209	2	58	27	4955,0,3,52.94,19.45,1",
+              "116001217	78392209	2	58	27	4955,0,3,52.94,abc",
+              "116001217	78392209	2	58	27	4955,0,3,52.94,19.45  "
+              "5264,1,14,80.03,47.38",
+              "116001217	78392209	x	58	27	"}) {
+            REQUIRE_THROWS(parse_line(line));
+        }
+    }
+}
+
+TEST_CASE("Test parser::parse_line into an existing Row",
+          "[parser::parse_line]") {
+    Row row;
+    row.players = {Player(1, 2, 3, 4, 5), Player(6, 7, 8, 9, 10)};
+
+    SECTION("Previous players are overwritten") {
+        std::string line = "1	2	1	3	4	0,11,7,1.5,2.5\r\n";
+        parse_line(line.data(), line.data() + line.size(), row);
+
+        REQUIRE(row.match_id == 1);
+        REQUIRE(row.timestamp == 2);
+        REQUIRE(row.half == 1);
+        REQUIRE(row.minute == 3);
+        REQUIRE(row.second == 4);
+        REQUIRE(row.players == player_seq{Player(0, 11, 7, 1.5, 2.5)});
+    }
+
+    SECTION("Only the given range is parsed") {
+        std::string line = "1	2	1	3	4	0,11,7,1.5,2.5 1,12,8,3,4";
+        parse_line(line.data(), line.data() + line.size() - 10, row);
+
+        REQUIRE(row.players == player_seq{Player(0, 11, 7, 1.5, 2.5)});
+        REQUIRE(row.players[0].x == 1.5);
+        REQUIRE(row.players[0].y == 2.5);
+    }
+
+    SECTION("Players are grouped by their types") {
+        std::string line = "1	2	1	3	4	"
+                           "1,11,7,1,1 0,12,8,2,2 2,13,0,3,3 0,14,9,4,4";
+        parse_line(line.data(), line.data() + line.size(), row);
+
+        REQUIRE((row.players ==
+                 player_seq{Player(0, 12, 8, 2, 2),
+                            Player(0, 14, 9, 4, 4),
+                            Player(1, 11, 7, 1, 1),
+                            Player(2, 13, 0, 3, 3)}));
+    }
+}
+
+TEST_CASE("Test parser::parse_into", "[parser::parse_into]") {
+    Row row;
+
+    SECTION("Parsed lines are the same as parse_line") {
+        const std::string line = "1	2	1	3	4	1,5,6,7,8 0,11,7,1.5,2.5\r\n";
+        const ParseResult result = parse_into(line, row);
+        REQUIRE(result.ok());
+        REQUIRE(result.offset == 0);
+        REQUIRE(row == parse_line(line));
+    }
+
+    SECTION("Malformed lines give the status and offset of the error") {
+        const std::vector<std::pair<std::string, ParseResult>> cases{
+            {"", {ParseStatus::tab_split, 0}},
+            {"116001217	78392209	2	58", {ParseStatus::tab_split, 23}},
+            {"1	2	1	3	4	0,1,2,3,4	", {ParseStatus::tab_split, 19}},
+            {"1	2	1	3	4	0,1,2,3", {ParseStatus::comma_split, 17}},
+            {"1	2	1	3	4	0,1,2,3,4,5", {ParseStatus::comma_split, 19}},
+            {"1	2	1	3	4	0,1,2,3,4  0,1,2,3,4",
+             {ParseStatus::comma_split, 20}},
+            {"1	2	x	3	4	", {ParseStatus::bad_integer, 4}},
+            {"1	2	1	3	4	0,1,2.5,3,4", {ParseStatus::bad_integer, 14}},
+            {"4294967297	2	1	3	4	", {ParseStatus::bad_integer, 0}},
+            {"1	2	1	-2147483649	4	", {ParseStatus::bad_integer, 6}},
+            {"1	2	1	3	4	0,4294967297,2,3,4",
+             {ParseStatus::bad_integer, 12}},
+            {"1	2	1	3	4	0,1,2,3,abc", {ParseStatus::bad_double, 18}}};
+        for (const auto& c : cases) {
+            const ParseResult result = parse_into(c.first, row);
+            REQUIRE(result.status == c.second.status);
+            REQUIRE(result.offset == c.second.offset);
+            REQUIRE_THROWS_WITH(parse_line(c.first),
+                                Catch::Contains(parse_status_message(
+                                    c.second.status)));
+        }
+
+        // timestamps are stored in a long
+        REQUIRE(parse_into("1	4294967297	1	3	4	", row).ok());
+        REQUIRE(row.timestamp == 4294967297);
+    }
+
+    SECTION("Memory of the row is reused after a malformed line") {
+        const std::string line = "1	2	1	3	4	0,1,2,3,4 0,2,2,3,4";
+        REQUIRE(parse_into(line, row).ok());
+        const Player* players = row.players.data();
+        REQUIRE_FALSE(parse_into("1	2	1	3	4	0,1,2,3,x", row).ok());
+        REQUIRE(parse_into(line, row).ok());
+        REQUIRE(row.players.size() == 2);
+        REQUIRE(row.players.data() == players);
     }
 }
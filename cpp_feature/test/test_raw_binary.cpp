@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <feature/player.hpp>
+#include <feature/row.hpp>
+#include <raw_binary.hpp>
+#include <raw_reader.hpp>
+
+using namespace feature;
+
+TEST_CASE("Test binary raw format", "[raw_binary]") {
+    const std::string raw_filepath = "test_raw_binary_rawdata.txt";
+    const std::string binary_filepath = "test_raw_binary_rawdata.bin";
+    {
+        std::ofstream ofs(raw_filepath, std::ofstream::binary);
+        ofs << "0 1\n"
+            << "5	100	1	0	0	0,1,2,3.5,4.5 1,7,8,-1.25,100.75 \n"
+            << "5	200	1	0	0	\n"
+            << "5	1100	1	0	1	4,9,-1,0.01,67.99\n";
+    }
+
+    REQUIRE_FALSE(is_raw_binary(raw_filepath));
+    REQUIRE(convert_raw_to_binary(raw_filepath, binary_filepath) == 3);
+    REQUIRE(is_raw_binary(binary_filepath));
+
+    BinaryRawReader reader(binary_filepath);
+    REQUIRE(reader.size() == 3);
+    REQUIRE_FALSE(reader.converted());
+    REQUIRE(reader.home_left());
+
+    SECTION("Sequential frames are the same as the text frames") {
+        RawReader text_reader(raw_filepath);
+        Row text_row, binary_row;
+        while (text_reader.next(text_row)) {
+            REQUIRE(reader.next(binary_row));
+            REQUIRE(binary_row == text_row);
+            for (size_t i = 0; i < text_row.players.size(); ++i) {
+                REQUIRE(binary_row.players[i].x == text_row.players[i].x);
+                REQUIRE(binary_row.players[i].y == text_row.players[i].y);
+            }
+        }
+        REQUIRE_FALSE(reader.next(binary_row));
+    }
+
+    SECTION("Random access by frame index") {
+        Row row;
+        reader.frame(2, row);
+        REQUIRE(row.timestamp == 1100);
+        REQUIRE(row.players == player_seq{Player(4, 9, -1, 0, 0)});
+        REQUIRE(row.players[0].y == 67.99);
+
+        reader.frame(1, row);
+        REQUIRE(row.timestamp == 200);
+        REQUIRE(row.players.empty());
+    }
+
+    SECTION("next_second skips frames of the same second") {
+        Row row;
+        REQUIRE(reader.next_second(row));
+        REQUIRE(row.timestamp == 100);
+        REQUIRE(reader.next_second(row));
+        REQUIRE(row.timestamp == 1100);
+        REQUIRE_FALSE(reader.next_second(row));
+    }
+
+    SECTION("Text files can't be read as binary files") {
+        REQUIRE_THROWS(BinaryRawReader(raw_filepath));
+    }
+
+    std::remove(raw_filepath.c_str());
+    std::remove(binary_filepath.c_str());
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <feature/player.hpp>
+#include <feature/row.hpp>
+#include <parser.hpp>
+#include <raw_reader.hpp>
+
+using namespace feature;
+
+/**
+ * @brief Write the given contents to a file and return its path.
+ */
+static std::string write_raw_file(const std::string& contents) {
+    const std::string filepath = "test_raw_reader_rawdata.txt";
+    std::ofstream ofs(filepath, std::ofstream::binary);
+    ofs << contents;
+    return filepath;
+}
+
+TEST_CASE("Test RawReader", "[RawReader]") {
+    SECTION("Header flags and all lines are read") {
+        auto filepath = write_raw_file("0 1\n"
+                                       "5	100	1	0	0	0,1,2,3.5,4.5 \n"
+                                       "5	200	1	0	0	\n"
+                                       "5	1100	1	0	1	1,2,3,4,5");
+        RawReader reader(filepath);
+        REQUIRE_FALSE(reader.converted());
+        REQUIRE(reader.home_left());
+
+        Row row;
+        REQUIRE(reader.next(row));
+        REQUIRE(row.timestamp == 100);
+        REQUIRE(row.players == player_seq{Player(0, 1, 2, 3.5, 4.5)});
+
+        REQUIRE(reader.next(row));
+        REQUIRE(row.timestamp == 200);
+        REQUIRE(row.players.empty());
+
+        REQUIRE(reader.next(row));
+        REQUIRE(row.timestamp == 1100);
+        REQUIRE(row.second == 1);
+        REQUIRE(row.players == player_seq{Player(1, 2, 3, 4, 5)});
+
+        REQUIRE_FALSE(reader.next(row));
+        std::remove(filepath.c_str());
+    }
+
+    SECTION("next_second returns only the first line of each second") {
+        auto filepath = write_raw_file("1 1\n"
+                                       "5	100	1	0	0	0,1,2,3,4\n"
+                                       "5	200	1	0	0	malformed\n"
+                                       "5	1100	1	0	1	0,1,2,5,6\n"
+                                       "5	1200	1	0	1	0,1,2,7,8\n"
+                                       "5	2100	2	0	1	\n");
+        RawReader reader(filepath);
+
+        Row row;
+        REQUIRE(reader.next_second(row));
+        REQUIRE(row.timestamp == 100);
+
+        REQUIRE(reader.next_second(row));
+        REQUIRE(row.timestamp == 1100);
+        REQUIRE(row.players == player_seq{Player(0, 1, 2, 5, 6)});
+        REQUIRE(row.players[0].x == 5);
+
+        REQUIRE(reader.next_second(row));
+        REQUIRE(row.timestamp == 2100);
+        REQUIRE(row.half == 2);
+
+        REQUIRE_FALSE(reader.next_second(row));
+        std::remove(filepath.c_str());
+    }
+
+    SECTION("Malformed lines throw or are skipped") {
+        const std::string contents = "0 1\n"
+                                     "5	100	1	0	0	0,1,2,3,4\n"
+                                     "5	200	1	0	0	0,1,x,3,4\n"
+                                     "5	1100	1	0	1\n"
+                                     "5	1200	1	0	1	0,1,2,5,6\n";
+        auto filepath = write_raw_file(contents);
+        Row row;
+
+        SECTION("Error message contains the line and the byte offset") {
+            RawReader reader(filepath);
+            REQUIRE(reader.next(row));
+            const size_t offset = contents.find('x');
+            REQUIRE_THROWS_WITH(reader.next(row),
+                                Catch::Contains("line 3, byte " +
+                                                std::to_string(offset)));
+        }
+
+        SECTION("next skips and counts malformed lines") {
+            RawReader reader(filepath, true);
+            REQUIRE(reader.next(row));
+            REQUIRE(row.timestamp == 100);
+            REQUIRE(reader.next(row));
+            REQUIRE(row.timestamp == 1200);
+            REQUIRE_FALSE(reader.next(row));
+            REQUIRE(reader.malformed() == 2);
+        }
+
+        SECTION("next_second skips a malformed first line of a second") {
+            RawReader reader(filepath, true);
+            REQUIRE(reader.next_second(row));
+            REQUIRE(row.timestamp == 100);
+            REQUIRE(reader.next_second(row));
+            REQUIRE(row.timestamp == 1200);
+            REQUIRE(row.players == player_seq{Player(0, 1, 2, 5, 6)});
+            REQUIRE_FALSE(reader.next_second(row));
+            // the malformed line of the first second is never parsed
+            REQUIRE(reader.malformed() == 1);
+        }
+        std::remove(filepath.c_str());
+    }
+
+    SECTION("Lines across and longer than the index windows") {
+        // short lines cross the window boundaries; the line with many
+        // players doesn't fit in a single window
+        std::vector<std::string> lines;
+        for (int i = 0; i < 3000; ++i) {
+            lines.push_back("5	" + std::to_string(100 * i) +
+                            "	1	0	0	0,1,2,3.5,4.5 1,7,8,9.25,10");
+        }
+        std::string players;
+        while (players.size() < 3 * RawReader::index_window) {
+            players += "1,2,3,4.5,5.5 ";
+        }
+        lines[1000] = "5	100000	1	0	0	" + players;
+        std::string contents = "0 1\n";
+        for (const auto& line : lines) {
+            contents += line + "\n";
+        }
+        auto filepath = write_raw_file(contents);
+
+        RawReader reader(filepath);
+        Row row;
+        for (const auto& line : lines) {
+            REQUIRE(reader.next(row));
+            REQUIRE(row == parse_line(line));
+        }
+        REQUIRE_FALSE(reader.next(row));
+        std::remove(filepath.c_str());
+    }
+
+    SECTION("File with only the header") {
+        auto filepath = write_raw_file("1 0\n");
+        RawReader reader(filepath);
+        REQUIRE(reader.converted());
+        REQUIRE_FALSE(reader.home_left());
+
+        Row row;
+        REQUIRE_FALSE(reader.next(row));
+        std::remove(filepath.c_str());
+    }
+
+    SECTION("Malformed header throws") {
+        auto filepath = write_raw_file("abc\n");
+        REQUIRE_THROWS(RawReader(filepath));
+        std::remove(filepath.c_str());
+    }
+
+    SECTION("Non-existing file throws") { REQUIRE_THROWS(RawReader("")); }
+}
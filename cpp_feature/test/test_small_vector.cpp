@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <small_vector.hpp>
+
+typedef SmallVector<int, 4> small_vec;
+
+/**
+ * @brief Return a SmallVector holding 0, 1, ..., n - 1.
+ */
+static small_vec iota(int n) {
+    small_vec v;
+    for (int i = 0; i < n; ++i) {
+        v.push_back(i);
+    }
+    return v;
+}
+
+TEST_CASE("Test SmallVector", "[SmallVector]") {
+    SECTION("Elements are stored inline up to the inline capacity") {
+        small_vec v;
+        REQUIRE(v.empty());
+        REQUIRE(v.capacity() == small_vec::inline_capacity);
+        for (int i = 0; i < 4; ++i) {
+            v.emplace_back(i);
+        }
+        REQUIRE(v.is_inline());
+        REQUIRE(v.size() == 4);
+        REQUIRE(std::accumulate(v.begin(), v.end(), 0) == 6);
+        REQUIRE(v.front() == 0);
+        REQUIRE(v.back() == 3);
+    }
+
+    SECTION("Elements are moved to the heap beyond the inline capacity") {
+        small_vec v = iota(11);
+        REQUIRE_FALSE(v.is_inline());
+        REQUIRE(v.size() == 11);
+        REQUIRE(v.capacity() >= 11);
+        for (int i = 0; i < 11; ++i) {
+            REQUIRE(v[i] == i);
+        }
+
+        // capacity doesn't shrink
+        v.clear();
+        REQUIRE(v.empty());
+        REQUIRE_FALSE(v.is_inline());
+        v.push_back(5);
+        REQUIRE((v == small_vec{5}));
+    }
+
+    SECTION("Copies are independent") {
+        for (int n : {3, 9}) {
+            small_vec v = iota(n);
+            small_vec copy = v;
+            REQUIRE(copy == v);
+            copy[0] = 100;
+            REQUIRE(v[0] == 0);
+            REQUIRE(copy != v);
+
+            small_vec assigned{7, 8};
+            assigned = v;
+            REQUIRE(assigned == v);
+            REQUIRE(assigned.is_inline() == (n <= 4));
+        }
+    }
+
+    SECTION("Moves leave the source empty") {
+        for (int n : {3, 9}) {
+            small_vec v = iota(n);
+            const int* data = v.data();
+            small_vec moved = std::move(v);
+            REQUIRE(moved == iota(n));
+            REQUIRE(v.empty());
+            // heap memory is moved without copying
+            REQUIRE((moved.data() == data) == (n > 4));
+
+            small_vec assigned = iota(2);
+            assigned = std::move(moved);
+            REQUIRE(assigned == iota(n));
+            REQUIRE(moved.empty());
+        }
+    }
+
+    SECTION("Resize fills the new elements") {
+        small_vec v(2, 7);
+        REQUIRE((v == small_vec{7, 7}));
+        v.resize(6, 1);
+        REQUIRE((v == small_vec{7, 7, 1, 1, 1, 1}));
+        v.resize(1);
+        REQUIRE((v == small_vec{7}));
+        v.resize(3);
+        REQUIRE((v == small_vec{7, 0, 0}));
+        v.pop_back();
+        REQUIRE(v.size() == 2);
+    }
+
+    SECTION("Out of range access throws") {
+        small_vec v = iota(2);
+        REQUIRE(v.at(1) == 1);
+        REQUIRE_THROWS_AS(v.at(2), const std::out_of_range&);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2018 Esref Ozdemir
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch/catch.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <thread_pool.hpp>
+
+TEST_CASE("Test ThreadPool", "[ThreadPool]") {
+    SECTION("0 threads uses at least one worker") {
+        ThreadPool pool(0);
+        REQUIRE(pool.size() >= 1);
+    }
+
+    SECTION("Results of the tasks are returned in futures") {
+        ThreadPool pool(4);
+        REQUIRE(pool.size() == 4);
+
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.push_back(pool.submit([i]() { return i * i; }));
+        }
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(results[i].get() == i * i);
+        }
+    }
+
+    SECTION("Exceptions are stored in futures") {
+        ThreadPool pool(2);
+        auto res = pool.submit([]() -> int { throw std::runtime_error("x"); });
+        REQUIRE_THROWS_AS(res.get(), const std::runtime_error&);
+    }
+
+    SECTION("Destructor waits for all the submitted tasks") {
+        std::atomic<int> count{0};
+        {
+            ThreadPool pool(3);
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&count]() { ++count; });
+            }
+        }
+        REQUIRE(count == 1000);
+    }
+}
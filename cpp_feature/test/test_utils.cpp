@@ -16,6 +16,7 @@
 
 #include <catch/catch.hpp>
 
+#include <cmath>
 #include <fstream>
 #include <iterator>
 #include <map>
@@ -142,6 +143,77 @@ TEST_CASE("Test utils::rtrim", "[utils::rtrim]") {
     REQUIRE(s == "\n1 2\n35");
 }
 
+TEST_CASE("Test utils::parse_int", "[utils::parse_int]") {
+    long value = 7;
+
+    SECTION("Whole range is an integer") {
+        std::string s{"-1234"};
+        const char* end = parse_int(s.data(), s.data() + s.size(), value);
+        REQUIRE(end == s.data() + s.size());
+        REQUIRE(value == -1234);
+    }
+
+    SECTION("Parsing stops at the first non-digit") {
+        std::string s{"+56,78"};
+        const char* end = parse_int(s.data(), s.data() + s.size(), value);
+        REQUIRE(end == s.data() + 3);
+        REQUIRE(value == 56);
+    }
+
+    SECTION("No digits doesn't modify value") {
+        for (const std::string s : {"", "-", "abc", " 12"}) {
+            const char* end = parse_int(s.data(), s.data() + s.size(), value);
+            REQUIRE(end == s.data());
+            REQUIRE(value == 7);
+        }
+    }
+
+    SECTION("Overflow doesn't modify value") {
+        std::string s{"99999999999999999999"};
+        const char* end = parse_int(s.data(), s.data() + s.size(), value);
+        REQUIRE(end == s.data());
+        REQUIRE(value == 7);
+    }
+}
+
+TEST_CASE("Test utils::parse_double", "[utils::parse_double]") {
+    double value = 7;
+
+    SECTION("Results are the same as std::stod") {
+        for (const std::string s :
+             {"0", "-0", "52.94", "104.79", "-0.52", "0.1", "3.14159265358979",
+              "1e-05", "2.5E3", "123456789012345678901234", "1.7976931348e308",
+              "0.000000000000000000000000001", ".5", "7."}) {
+            const char* end = parse_double(s.data(), s.data() + s.size(), value);
+            REQUIRE(end == s.data() + s.size());
+            REQUIRE(value == std::stod(s));
+            REQUIRE(std::signbit(value) == std::signbit(std::stod(s)));
+        }
+    }
+
+    SECTION("Parsing stops at the first character not part of the number") {
+        std::string s{"80.03,47.38"};
+        const char* end = parse_double(s.data(), s.data() + s.size(), value);
+        REQUIRE(end == s.data() + 5);
+        REQUIRE(value == 80.03);
+
+        s = "12e";
+        end = parse_double(s.data(), s.data() + s.size(), value);
+        REQUIRE(end == s.data() + 2);
+        REQUIRE(value == 12);
+    }
+
+    SECTION("No digits doesn't modify value") {
+        value = 7;
+        for (const std::string s : {"", "-", "abc", " 12", "."}) {
+            const char* end =
+                parse_double(s.data(), s.data() + s.size(), value);
+            REQUIRE(end == s.data());
+            REQUIRE(value == 7);
+        }
+    }
+}
+
 TEST_CASE("Test utils::close", "[utils::close]") {
     REQUIRE(close(1.1235473727, 1.123547372));
 
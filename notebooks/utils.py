@@ -526,6 +526,76 @@ def read_feature_csv(path):
     return home_id, away_id, df
 
 
+def read_feature_npy(path, mmap=True):
+    """
+    Reads a feature file written by the C++ feature executable with
+    --format npy and returns it as a dataframe.
+
+    The file holds a structured array with a float64 field for half, minute,
+    second and each feature. No text parsing is done; if mmap is True, the
+    file is memory-mapped instead of read into memory.
+
+    Parameters
+    ----------
+    path : str
+        Path to the .npy feature file.
+
+    mmap : bool
+        Whether to memory-map the file.
+
+    Returns
+    -------
+    df : pandas.DataFrame
+        Feature dataframe with the same columns as the feature csv files.
+    """
+    arr = np.load(path, mmap_mode='r' if mmap else None)
+    return pd.DataFrame(arr)
+
+
+def read_feature_columnar(path):
+    """
+    Reads a feature file written by the C++ feature executable with
+    --format columnar and returns it as a dataframe.
+
+    The file has a 32 byte header (magic, version, number of columns, number
+    of rows and offset of the column data), followed by the column names and
+    the float64 values of each column stored contiguously. Columns are
+    memory-mapped; no text parsing is done.
+
+    Parameters
+    ----------
+    path : str
+        Path to the columnar feature file.
+
+    Returns
+    -------
+    df : pandas.DataFrame
+        Feature dataframe with the same columns as the feature csv files.
+    """
+    header = np.fromfile(path, dtype=np.uint8, count=32).tobytes()
+    if header[:8] != b'SIUFEAT\0':
+        raise ValueError('{} is not a columnar feature file'.format(path))
+    version, num_columns = np.frombuffer(header[8:16], dtype=np.uint32)
+    num_rows, data_offset = np.frombuffer(header[16:32], dtype=np.uint64)
+    if version != 1:
+        raise ValueError('Unsupported columnar file version {}'.format(version))
+
+    # read column names
+    schema = np.fromfile(path, dtype=np.uint8, count=int(data_offset)).tobytes()
+    names = []
+    pos = 32
+    for _ in range(num_columns):
+        length = int(np.frombuffer(schema[pos:pos + 4], dtype=np.uint32)[0])
+        names.append(schema[pos + 4:pos + 4 + length].decode())
+        pos += 4 + length
+
+    columns = np.memmap(path, dtype=np.float64, mode='r',
+                        offset=int(data_offset),
+                        shape=(int(num_columns), int(num_rows)))
+    return pd.DataFrame({name: columns[i] for i, name in enumerate(names)},
+                        columns=names)
+
+
 def remove_missing_raw_rows(raw_df):
     """
     Removes rows from raw data dataframe that contains missing player data.